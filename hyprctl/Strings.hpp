@@ -40,8 +40,12 @@ commands:
     plugin ...          → Issue a plugin request
     reload [config-only] → Issue a reload to force reload the config. Pass
                           'config-only' to disable monitor reload
+    renderstats [reset] → Prints render timings and GL counters since the
+                          last reset, or resets them
     rollinglog          → Prints tail of the log. Also supports -f/--follow
                           option
+    scanout             → Lists direct scanout candidates, hit rates and
+                          per-surface dmabuf feedback tranches
     setcursor <theme> <size> → Sets the cursor theme and reloads the cursor
                           manager
     seterror <color> <message...> → Sets the hyprctl error string. Color has
@@ -57,10 +61,14 @@ commands:
     workspaces          → Lists all workspaces with their properties
 
 flags:
-    -j                  → Output in JSON
+    -j                  → Output in JSON. Info commands also accept a trailing
+                          'fields:<key,...>' argument to only emit those keys,
+                          e.g. 'hyprctl -j clients fields:address,title'
     -r                  → Refresh state after issuing command (e.g. for
                           updating variables)
     --batch             → Execute a batch of commands, separated by ';'
+    --session           → Keep one connection open and run requests read
+                          from stdin, one per line
     --instance (-i)     → use a specific instance. Can be either signature or
                           index in hyprctl instances (0, 1, etc)
     --quiet (-q)        → Disable the output of hyprctl
@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 #include <deque>
+#include <array>
+#include <poll.h>
 #include <filesystem>
 #include <cstdarg>
 #include <regex>
@@ -145,33 +147,26 @@ int rollingRead(const int socket) {
     return 0;
 }
 
-int request(std::string arg, int minArgs = 0, bool needRoll = false) {
+// returns the connected fd, or the negated error code
+int connectToHyprland() {
     const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
 
-    auto       t = timeval{.tv_sec = 5, .tv_usec = 0};
-    setsockopt(SERVERSOCKET, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(struct timeval));
-
-    const auto ARGS = std::count(arg.begin(), arg.end(), ' ');
-
-    if (ARGS < minArgs) {
-        log(std::format("Not enough arguments in '{}', expected at least {}", arg, minArgs));
-        return -1;
-    }
-
     if (SERVERSOCKET < 0) {
         log("Couldn't open a socket (1)");
-        return 1;
+        return -1;
     }
 
+    auto t = timeval{.tv_sec = 5, .tv_usec = 0};
+    setsockopt(SERVERSOCKET, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(struct timeval));
+
     if (instanceSignature.empty()) {
         log("HYPRLAND_INSTANCE_SIGNATURE was not set! (Is Hyprland running?)");
-        return 2;
+        close(SERVERSOCKET);
+        return -2;
     }
 
-    const std::string USERID = std::to_string(getpwuid(getuid())->pw_uid);
-
-    sockaddr_un       serverAddress = {0};
-    serverAddress.sun_family        = AF_UNIX;
+    sockaddr_un serverAddress = {0};
+    serverAddress.sun_family  = AF_UNIX;
 
     std::string socketPath = getRuntimeDir() + "/" + instanceSignature + "/.socket.sock";
 
@@ -179,9 +174,26 @@ int request(std::string arg, int minArgs = 0, bool needRoll = false) {
 
     if (connect(SERVERSOCKET, (sockaddr*)&serverAddress, SUN_LEN(&serverAddress)) < 0) {
         log("Couldn't connect to " + socketPath + ". (3)");
-        return 3;
+        close(SERVERSOCKET);
+        return -3;
+    }
+
+    return SERVERSOCKET;
+}
+
+int request(std::string arg, int minArgs = 0, bool needRoll = false) {
+    const auto ARGS = std::count(arg.begin(), arg.end(), ' ');
+
+    if (ARGS < minArgs) {
+        log(std::format("Not enough arguments in '{}', expected at least {}", arg, minArgs));
+        return -1;
     }
 
+    const auto SERVERSOCKET = connectToHyprland();
+
+    if (SERVERSOCKET < 0)
+        return -SERVERSOCKET;
+
     auto sizeWritten = write(SERVERSOCKET, arg.c_str(), arg.length());
 
     if (sizeWritten < 0) {
@@ -222,6 +234,154 @@ int request(std::string arg, int minArgs = 0, bool needRoll = false) {
     return 0;
 }
 
+static bool writeAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        const auto WRITTEN = write(fd, data, len);
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        data += WRITTEN;
+        len -= WRITTEN;
+    }
+
+    return true;
+}
+
+/*
+    Persistent session: one connection for many requests.
+    After the "[[SESSION]]" handshake, every request and reply is framed as
+    [u32 payload length][u32 request id][payload] in host byte order.
+    Requests are read from stdin, one per line, and sent without waiting for earlier replies,
+    with up to SESSION_WINDOW of them in flight. Replies come back in request order and are
+    printed as they arrive.
+*/
+int sessionRequest(const std::string& flags) {
+    constexpr size_t SESSION_WINDOW  = 32;
+    constexpr int    SESSION_TIMEOUT = 5000; // ms without a reply while requests are in flight
+
+    const auto       SERVERSOCKET = connectToHyprland();
+
+    if (SERVERSOCKET < 0)
+        return -SERVERSOCKET;
+
+    const auto fail = [SERVERSOCKET](int code, const std::string& msg) {
+        log(msg);
+        close(SERVERSOCKET);
+        return code;
+    };
+
+    const std::string HANDSHAKE = "[[SESSION]]";
+    if (!writeAll(SERVERSOCKET, HANDSHAKE.c_str(), HANDSHAKE.length()))
+        return fail(4, "Couldn't write (4)");
+
+    uint32_t                nextID    = 0;
+    bool                    stdinOpen = true;
+    std::string             stdinBuffer;
+    std::string             replyBuffer;
+    std::deque<std::string> queued;
+    std::deque<uint32_t>    inFlight;
+    std::array<char, 8192>  buffer = {0};
+
+    while (stdinOpen || !queued.empty() || !inFlight.empty()) {
+        // send everything that fits in the window before waiting for replies
+        while (!queued.empty() && inFlight.size() < SESSION_WINDOW) {
+            const std::string RQ        = flags + "/" + queued.front();
+            const uint32_t    HEADER[2] = {(uint32_t)RQ.length(), nextID};
+            queued.pop_front();
+
+            if (!writeAll(SERVERSOCKET, (const char*)HEADER, sizeof(HEADER)) || !writeAll(SERVERSOCKET, RQ.c_str(), RQ.length()))
+                return fail(4, "Couldn't write (4)");
+
+            inFlight.push_back(nextID++);
+        }
+
+        pollfd pollfds[] = {
+            {
+                .fd     = stdinOpen && queued.empty() ? STDIN_FILENO : -1,
+                .events = POLLIN,
+            },
+            {
+                .fd     = SERVERSOCKET,
+                .events = POLLIN,
+            },
+        };
+
+        const auto RET = poll(pollfds, 2, inFlight.empty() ? -1 : SESSION_TIMEOUT);
+
+        if (RET < 0) {
+            if (errno == EINTR)
+                continue;
+            return fail(5, std::format("Couldn't read (5): {}", strerror(errno)));
+        }
+
+        if (RET == 0) {
+            log("Hyprland IPC didn't respond in time\n");
+            return fail(5, "Couldn't read (5)");
+        }
+
+        if (pollfds[0].revents) {
+            const auto READ = read(STDIN_FILENO, buffer.data(), buffer.size());
+            if (READ < 0 && errno != EINTR)
+                return fail(5, std::format("Couldn't read stdin (5): {}", strerror(errno)));
+
+            if (READ == 0) {
+                stdinOpen = false;
+                stdinBuffer += '\n';
+            } else if (READ > 0)
+                stdinBuffer.append(buffer.data(), READ);
+
+            size_t start = 0;
+            for (size_t end = stdinBuffer.find('\n'); end != std::string::npos; end = stdinBuffer.find('\n', start)) {
+                if (end > start)
+                    queued.emplace_back(stdinBuffer.substr(start, end - start));
+                start = end + 1;
+            }
+            stdinBuffer.erase(0, start);
+        }
+
+        if (!pollfds[1].revents)
+            continue;
+
+        const auto READ = read(SERVERSOCKET, buffer.data(), buffer.size());
+        if (READ < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            return fail(5, std::format("Couldn't read (5): {}", strerror(errno)));
+        }
+
+        if (READ == 0)
+            return fail(5, "Hyprland closed the session, couldn't read (5)");
+
+        replyBuffer.append(buffer.data(), READ);
+
+        size_t offset = 0;
+        while (replyBuffer.size() - offset >= 2 * sizeof(uint32_t)) {
+            uint32_t replyHeader[2] = {0};
+            std::memcpy(replyHeader, replyBuffer.data() + offset, sizeof(replyHeader));
+
+            if (replyBuffer.size() - offset - sizeof(replyHeader) < replyHeader[0])
+                break; // incomplete frame
+
+            if (inFlight.empty() || replyHeader[1] != inFlight.front())
+                return fail(6, std::format("Reply id mismatch, expected {} got {}", inFlight.empty() ? nextID : inFlight.front(), replyHeader[1]));
+
+            inFlight.pop_front();
+            log(replyBuffer.substr(offset + sizeof(replyHeader), replyHeader[0]));
+            std::cout << std::flush;
+
+            offset += sizeof(replyHeader) + replyHeader[0];
+        }
+        replyBuffer.erase(0, offset);
+    }
+
+    close(SERVERSOCKET);
+
+    return 0;
+}
+
 int requestHyprpaper(std::string arg) {
     const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
 
@@ -338,6 +498,7 @@ int main(int argc, char** argv) {
     const auto  ARGS             = splitArgs(argc, argv);
     bool        json             = false;
     bool        needRoll         = false;
+    bool        session          = false;
     std::string overrideInstance = "";
 
     for (std::size_t i = 0; i < ARGS.size(); ++i) {
@@ -362,6 +523,8 @@ int main(int argc, char** argv) {
                 needRoll = true;
             } else if (ARGS[i] == "--batch") {
                 fullRequest = "--batch ";
+            } else if (ARGS[i] == "--session") {
+                session = true;
             } else if (ARGS[i] == "--instance" || ARGS[i] == "-i") {
                 ++i;
 
@@ -404,12 +567,13 @@ int main(int argc, char** argv) {
         fullRequest += ARGS[i] + " ";
     }
 
-    if (fullRequest.empty()) {
+    if (fullRequest.empty() && !session) {
         std::println("{}", USAGE);
         return 1;
     }
 
-    fullRequest.pop_back(); // remove trailing space
+    if (!fullRequest.empty())
+        fullRequest.pop_back(); // remove trailing space
 
     fullRequest = fullArgs + "/" + fullRequest;
 
@@ -455,7 +619,9 @@ int main(int argc, char** argv) {
 
     int exitStatus = 0;
 
-    if (fullRequest.contains("/--batch"))
+    if (session)
+        exitStatus = sessionRequest(fullArgs);
+    else if (fullRequest.contains("/--batch"))
         batchRequest(fullRequest, json);
     else if (fullRequest.contains("/hyprpaper"))
         exitStatus = requestHyprpaper(fullRequest);
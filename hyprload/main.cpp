@@ -0,0 +1,556 @@
+#include <wayland-client.h>
+#include "xdg-shell-client-protocol.h"
+#include "linux-dmabuf-v1-client-protocol.h"
+
+#include <gbm.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <print>
+#include <sstream>
+#include <string>
+#include <vector>
+
+constexpr const char* USAGE = R"#(usage: hyprload [options]
+
+Connects to $WAYLAND_DISPLAY and drives the surface, subsurface, buffer and xdg-shell
+paths of the compositor, then prints commit-to-frame-callback latency and compositor
+CPU time per commit.
+
+Options:
+    --toplevels N       toplevels to create (default: 64)
+    --subsurfaces N     subsurfaces per toplevel, in a binary tree (default: 0)
+    --desync            make subsurfaces desynchronized
+    --rate HZ           commits per second per toplevel, 0 commits on each frame
+                        callback (default: 0)
+    --duration S        seconds to measure (default: 10)
+    --warmup S          seconds to run before measuring (default: 1)
+    --buffer shm|dmabuf buffer type (default: shm)
+    --drm-device PATH   render node for dmabuf buffers (default: /dev/dri/renderD128)
+    --size WxH          buffer size (default: 256x256)
+    --resize            change the buffer size on every commit
+    --damage full|partial
+                        damage the whole buffer, or a small moving rect (default: full)
+    -j, --json          print the results as JSON
+    -h, --help          show this message
+)#";
+
+struct SOptions {
+    int         toplevels   = 64;
+    int         subsurfaces = 0;
+    bool        desync      = false;
+    int         rate        = 0;
+    float       duration    = 10;
+    float       warmup      = 1;
+    bool        dmabuf      = false;
+    std::string drmDevice   = "/dev/dri/renderD128";
+    int         width       = 256;
+    int         height      = 256;
+    bool        resize      = false;
+    bool        fullDamage  = true;
+    bool        json        = false;
+} g_options;
+
+struct SSubsurface {
+    wl_surface*    surface    = nullptr;
+    wl_subsurface* subsurface = nullptr;
+};
+
+struct SToplevel {
+    wl_surface*              surface  = nullptr;
+    xdg_surface*             xdgSurf  = nullptr;
+    xdg_toplevel*            toplevel = nullptr;
+    std::vector<SSubsurface> children;
+
+    bool                     configured    = false;
+    bool                     frameInFlight = false;
+    uint64_t                 commits       = 0;
+};
+
+struct SFrameCallback {
+    SToplevel*                            toplevel = nullptr;
+    std::chrono::steady_clock::time_point committed;
+};
+
+struct SState {
+    wl_display*                             display       = nullptr;
+    wl_registry*                            registry      = nullptr;
+    wl_compositor*                          compositor    = nullptr;
+    wl_subcompositor*                       subcompositor = nullptr;
+    wl_shm*                                 shm           = nullptr;
+    xdg_wm_base*                            wmBase        = nullptr;
+    zwp_linux_dmabuf_v1*                    linuxDmabuf   = nullptr;
+
+    gbm_device*                             gbm     = nullptr;
+    int                                     drmFD   = -1;
+    wl_shm_pool*                            shmPool = nullptr;
+    int                                     shmFD   = -1;
+    size_t                                  shmSize = 0;
+    std::map<uint64_t, gbm_bo*>             dmabufBOs;
+
+    std::vector<std::unique_ptr<SToplevel>> toplevels;
+
+    // only counted after the warmup
+    bool               measuring  = false;
+    uint64_t           commits    = 0;
+    uint64_t           buffers    = 0;
+    uint64_t           framesDone = 0;
+    std::vector<float> latenciesMs;
+} g_state;
+
+static void fail(const std::string& msg) {
+    std::println(stderr, "hyprload: {}", msg);
+    exit(1);
+}
+
+// buffer sizes cycle through 8 steps between half and full size when resizing
+static std::pair<int, int> bufferSize(uint64_t commit) {
+    if (!g_options.resize)
+        return {g_options.width, g_options.height};
+
+    const int STEP = commit % 8;
+    return {g_options.width / 2 + (g_options.width / 2) * STEP / 7, g_options.height / 2 + (g_options.height / 2) * STEP / 7};
+}
+
+// ------------------------------------------------ buffers
+
+static const wl_buffer_listener bufferListener = {
+    .release = [](void* data, wl_buffer* buffer) { wl_buffer_destroy(buffer); },
+};
+
+static void createSHMPool() {
+    g_state.shmSize = (size_t)g_options.width * g_options.height * 4;
+    g_state.shmFD   = memfd_create("hyprload", MFD_CLOEXEC);
+
+    if (g_state.shmFD < 0 || ftruncate(g_state.shmFD, g_state.shmSize) < 0)
+        fail("couldn't allocate shm");
+
+    auto data = mmap(nullptr, g_state.shmSize, PROT_READ | PROT_WRITE, MAP_SHARED, g_state.shmFD, 0);
+    if (data == MAP_FAILED)
+        fail("couldn't map shm");
+
+    // contents don't matter, but keep them deterministic
+    memset(data, 0x7f, g_state.shmSize);
+    munmap(data, g_state.shmSize);
+
+    g_state.shmPool = wl_shm_create_pool(g_state.shm, g_state.shmFD, g_state.shmSize);
+}
+
+static gbm_bo* dmabufBO(int w, int h) {
+    const uint64_t KEY = ((uint64_t)w << 32) | h;
+
+    if (const auto IT = g_state.dmabufBOs.find(KEY); IT != g_state.dmabufBOs.end())
+        return IT->second;
+
+    const auto BO = gbm_bo_create(g_state.gbm, w, h, GBM_FORMAT_XRGB8888, GBM_BO_USE_RENDERING);
+    if (!BO)
+        fail(std::format("couldn't allocate a {}x{} dmabuf", w, h));
+
+    g_state.dmabufBOs[KEY] = BO;
+    return BO;
+}
+
+// every commit gets a fresh wl_buffer, so buffer import is part of the measured path
+static wl_buffer* createBuffer(int w, int h) {
+    wl_buffer* buffer = nullptr;
+
+    if (!g_options.dmabuf)
+        buffer = wl_shm_pool_create_buffer(g_state.shmPool, 0, w, h, w * 4, WL_SHM_FORMAT_XRGB8888);
+    else {
+        const auto BO       = dmabufBO(w, h);
+        const auto MODIFIER = gbm_bo_get_modifier(BO);
+        const auto PARAMS   = zwp_linux_dmabuf_v1_create_params(g_state.linuxDmabuf);
+
+        for (int i = 0; i < gbm_bo_get_plane_count(BO); ++i) {
+            const int FD = gbm_bo_get_fd_for_plane(BO, i);
+            zwp_linux_buffer_params_v1_add(PARAMS, FD, i, gbm_bo_get_offset(BO, i), gbm_bo_get_stride_for_plane(BO, i), MODIFIER >> 32, MODIFIER & 0xFFFFFFFF);
+            close(FD);
+        }
+
+        buffer = zwp_linux_buffer_params_v1_create_immed(PARAMS, w, h, GBM_FORMAT_XRGB8888, 0);
+        zwp_linux_buffer_params_v1_destroy(PARAMS);
+    }
+
+    wl_buffer_add_listener(buffer, &bufferListener, nullptr);
+
+    if (g_state.measuring)
+        g_state.buffers++;
+
+    return buffer;
+}
+
+// ------------------------------------------------ surfaces
+
+static void commitToplevel(SToplevel* toplevel);
+
+static const wl_callback_listener frameListener = {
+    .done =
+        [](void* data, wl_callback* callback, uint32_t time) {
+            const auto FRAME = (SFrameCallback*)data;
+
+            if (g_state.measuring) {
+                g_state.latenciesMs.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - FRAME->committed).count());
+                g_state.framesDone++;
+            }
+
+            FRAME->toplevel->frameInFlight = false;
+
+            if (g_options.rate == 0)
+                commitToplevel(FRAME->toplevel);
+
+            wl_callback_destroy(callback);
+            delete FRAME;
+        },
+};
+
+static void attachAndDamage(wl_surface* surface, uint64_t commit) {
+    const auto [W, H] = bufferSize(commit);
+
+    wl_surface_attach(surface, createBuffer(W, H), 0, 0);
+
+    if (g_options.fullDamage)
+        wl_surface_damage_buffer(surface, 0, 0, W, H);
+    else
+        wl_surface_damage_buffer(surface, (commit * 16) % std::max(1, W - 32), (commit * 16) % std::max(1, H - 32), 32, 32);
+}
+
+static void commitToplevel(SToplevel* toplevel) {
+    if (!toplevel->configured)
+        return;
+
+    const auto COMMIT = toplevel->commits++;
+
+    // children first, so a synchronized tree is applied by the root commit
+    for (auto& c : toplevel->children) {
+        attachAndDamage(c.surface, COMMIT);
+        wl_surface_commit(c.surface);
+    }
+
+    attachAndDamage(toplevel->surface, COMMIT);
+
+    const auto [W, H] = bufferSize(COMMIT);
+    xdg_surface_set_window_geometry(toplevel->xdgSurf, 0, 0, W, H);
+
+    // one callback in flight per toplevel, more would only measure queueing
+    if (!toplevel->frameInFlight) {
+        toplevel->frameInFlight = true;
+        wl_callback_add_listener(wl_surface_frame(toplevel->surface), &frameListener, new SFrameCallback{toplevel, std::chrono::steady_clock::now()});
+    }
+
+    wl_surface_commit(toplevel->surface);
+
+    if (g_state.measuring)
+        g_state.commits += 1 + toplevel->children.size();
+}
+
+static const xdg_surface_listener xdgSurfaceListener = {
+    .configure =
+        [](void* data, xdg_surface* xdgSurface, uint32_t serial) {
+            const auto TOPLEVEL = (SToplevel*)data;
+
+            xdg_surface_ack_configure(xdgSurface, serial);
+
+            if (TOPLEVEL->configured)
+                return;
+
+            TOPLEVEL->configured = true;
+            commitToplevel(TOPLEVEL);
+        },
+};
+
+static const xdg_toplevel_listener toplevelListener = {
+    .configure        = [](void* data, xdg_toplevel* toplevel, int32_t w, int32_t h, wl_array* states) {},
+    .close            = [](void* data, xdg_toplevel* toplevel) {},
+    .configure_bounds = [](void* data, xdg_toplevel* toplevel, int32_t w, int32_t h) {},
+    .wm_capabilities  = [](void* data, xdg_toplevel* toplevel, wl_array* caps) {},
+};
+
+static void createToplevel(int idx) {
+    auto toplevel = std::make_unique<SToplevel>();
+
+    toplevel->surface  = wl_compositor_create_surface(g_state.compositor);
+    toplevel->xdgSurf  = xdg_wm_base_get_xdg_surface(g_state.wmBase, toplevel->surface);
+    toplevel->toplevel = xdg_surface_get_toplevel(toplevel->xdgSurf);
+
+    xdg_surface_add_listener(toplevel->xdgSurf, &xdgSurfaceListener, toplevel.get());
+    xdg_toplevel_add_listener(toplevel->toplevel, &toplevelListener, toplevel.get());
+    xdg_toplevel_set_title(toplevel->toplevel, std::format("hyprload {}", idx).c_str());
+    xdg_toplevel_set_app_id(toplevel->toplevel, "hyprload");
+
+    // binary tree: child i hangs off the root or child (i - 1) / 2
+    for (int i = 0; i < g_options.subsurfaces; ++i) {
+        const auto PARENT = i == 0 ? toplevel->surface : toplevel->children[(i - 1) / 2].surface;
+
+        auto&      child = toplevel->children.emplace_back();
+        child.surface    = wl_compositor_create_surface(g_state.compositor);
+        child.subsurface = wl_subcompositor_get_subsurface(g_state.subcompositor, child.surface, PARENT);
+        wl_subsurface_set_position(child.subsurface, 8 * (i % 8), 8 * (i / 8));
+
+        if (g_options.desync)
+            wl_subsurface_set_desync(child.subsurface);
+    }
+
+    wl_surface_commit(toplevel->surface);
+
+    g_state.toplevels.emplace_back(std::move(toplevel));
+}
+
+// ------------------------------------------------ globals
+
+static const xdg_wm_base_listener wmBaseListener = {
+    .ping = [](void* data, xdg_wm_base* wmBase, uint32_t serial) { xdg_wm_base_pong(wmBase, serial); },
+};
+
+static const wl_registry_listener registryListener = {
+    .global =
+        [](void* data, wl_registry* registry, uint32_t name, const char* interface, uint32_t version) {
+            const std::string IFACE = interface;
+
+            if (IFACE == wl_compositor_interface.name)
+                g_state.compositor = (wl_compositor*)wl_registry_bind(registry, name, &wl_compositor_interface, std::min(version, 4u));
+            else if (IFACE == wl_subcompositor_interface.name)
+                g_state.subcompositor = (wl_subcompositor*)wl_registry_bind(registry, name, &wl_subcompositor_interface, 1);
+            else if (IFACE == wl_shm_interface.name)
+                g_state.shm = (wl_shm*)wl_registry_bind(registry, name, &wl_shm_interface, 1);
+            else if (IFACE == xdg_wm_base_interface.name) {
+                g_state.wmBase = (xdg_wm_base*)wl_registry_bind(registry, name, &xdg_wm_base_interface, std::min(version, 5u));
+                xdg_wm_base_add_listener(g_state.wmBase, &wmBaseListener, nullptr);
+            } else if (IFACE == zwp_linux_dmabuf_v1_interface.name && version >= 3)
+                g_state.linuxDmabuf = (zwp_linux_dmabuf_v1*)wl_registry_bind(registry, name, &zwp_linux_dmabuf_v1_interface, 3);
+        },
+    .global_remove = [](void* data, wl_registry* registry, uint32_t name) {},
+};
+
+// ------------------------------------------------ stats
+
+// utime + stime of the compositor, in clock ticks
+static uint64_t compositorCPUTicks(pid_t pid) {
+    std::ifstream stat(std::format("/proc/{}/stat", pid));
+    std::string   content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+
+    // comm can contain spaces, fields are counted from the closing paren
+    const auto PAREN = content.rfind(')');
+    if (PAREN == std::string::npos)
+        return 0;
+
+    std::istringstream fields(content.substr(PAREN + 2));
+    std::string        field;
+    uint64_t           utime = 0, stime = 0;
+
+    // state is field 3, utime and stime are fields 14 and 15
+    for (int i = 3; i <= 15 && fields >> field; ++i) {
+        if (i == 14)
+            utime = std::stoull(field);
+        else if (i == 15)
+            stime = std::stoull(field);
+    }
+
+    return utime + stime;
+}
+
+static float percentile(std::vector<float>& values, float p) {
+    if (values.empty())
+        return 0;
+
+    const auto NTH = std::min(values.size() - 1, (size_t)(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + NTH, values.end());
+    return values[NTH];
+}
+
+// ------------------------------------------------ main
+
+static bool parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string ARG = argv[i];
+
+        const auto        NEXT = [&]() -> std::string {
+            if (i + 1 >= argc)
+                fail(std::format("{} needs a value", ARG));
+            return argv[++i];
+        };
+
+        try {
+            if (ARG == "--toplevels")
+                g_options.toplevels = std::stoi(NEXT());
+            else if (ARG == "--subsurfaces")
+                g_options.subsurfaces = std::stoi(NEXT());
+            else if (ARG == "--desync")
+                g_options.desync = true;
+            else if (ARG == "--rate")
+                g_options.rate = std::stoi(NEXT());
+            else if (ARG == "--duration")
+                g_options.duration = std::stof(NEXT());
+            else if (ARG == "--warmup")
+                g_options.warmup = std::stof(NEXT());
+            else if (ARG == "--buffer") {
+                const auto TYPE = NEXT();
+                if (TYPE != "shm" && TYPE != "dmabuf")
+                    fail("--buffer must be shm or dmabuf");
+                g_options.dmabuf = TYPE == "dmabuf";
+            } else if (ARG == "--drm-device")
+                g_options.drmDevice = NEXT();
+            else if (ARG == "--size") {
+                const auto SIZE = NEXT();
+                const auto X    = SIZE.find('x');
+                if (X == std::string::npos)
+                    fail("--size must be WxH");
+                g_options.width  = std::stoi(SIZE.substr(0, X));
+                g_options.height = std::stoi(SIZE.substr(X + 1));
+            } else if (ARG == "--resize")
+                g_options.resize = true;
+            else if (ARG == "--damage") {
+                const auto TYPE = NEXT();
+                if (TYPE != "full" && TYPE != "partial")
+                    fail("--damage must be full or partial");
+                g_options.fullDamage = TYPE == "full";
+            } else if (ARG == "-j" || ARG == "--json")
+                g_options.json = true;
+            else if (ARG == "-h" || ARG == "--help") {
+                std::print("{}", USAGE);
+                return false;
+            } else
+                fail(std::format("unknown option {}\n\n{}", ARG, USAGE));
+        } catch (std::exception& e) { fail(std::format("invalid value for {}", ARG)); }
+    }
+
+    if (g_options.toplevels < 1 || g_options.subsurfaces < 0 || g_options.rate < 0 || g_options.width < 64 || g_options.height < 64)
+        fail("invalid options");
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parseArgs(argc, argv))
+        return 0;
+
+    g_state.display = wl_display_connect(nullptr);
+    if (!g_state.display)
+        fail("couldn't connect to the wayland display");
+
+    g_state.registry = wl_display_get_registry(g_state.display);
+    wl_registry_add_listener(g_state.registry, &registryListener, nullptr);
+    wl_display_roundtrip(g_state.display);
+
+    if (!g_state.compositor || !g_state.subcompositor || !g_state.shm || !g_state.wmBase)
+        fail("compositor is missing core globals");
+
+    if (g_options.dmabuf) {
+        if (!g_state.linuxDmabuf)
+            fail("compositor doesn't support linux-dmabuf v3");
+
+        g_state.drmFD = open(g_options.drmDevice.c_str(), O_RDWR | O_CLOEXEC);
+        g_state.gbm   = g_state.drmFD >= 0 ? gbm_create_device(g_state.drmFD) : nullptr;
+
+        if (!g_state.gbm)
+            fail(std::format("couldn't open {}", g_options.drmDevice));
+    } else
+        createSHMPool();
+
+    ucred     peer;
+    socklen_t peerLen = sizeof(peer);
+    if (getsockopt(wl_display_get_fd(g_state.display), SOL_SOCKET, SO_PEERCRED, &peer, &peerLen) < 0)
+        fail("couldn't get the compositor's pid");
+
+    for (int i = 0; i < g_options.toplevels; ++i) {
+        createToplevel(i);
+    }
+
+    int timerFD = -1;
+    if (g_options.rate > 0) {
+        timerFD = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+
+        const long       PERIODNS = 1000000000L / g_options.rate;
+        const timespec   PERIOD   = {.tv_sec = PERIODNS / 1000000000L, .tv_nsec = PERIODNS % 1000000000L};
+        const itimerspec INTERVAL = {.it_interval = PERIOD, .it_value = PERIOD};
+        timerfd_settime(timerFD, 0, &INTERVAL, nullptr);
+    }
+
+    const auto START          = std::chrono::steady_clock::now();
+    const auto WARMUPEND      = START + std::chrono::duration<float>(g_options.warmup);
+    const auto END            = WARMUPEND + std::chrono::duration<float>(g_options.duration);
+    uint64_t   cpuTicksStart  = 0;
+    auto       measuringStart = WARMUPEND;
+
+    while (true) {
+        const auto NOW = std::chrono::steady_clock::now();
+
+        if (!g_state.measuring && NOW >= WARMUPEND) {
+            g_state.measuring = true;
+            cpuTicksStart     = compositorCPUTicks(peer.pid);
+            measuringStart    = NOW;
+        }
+
+        if (NOW >= END)
+            break;
+
+        while (wl_display_prepare_read(g_state.display) != 0) {
+            wl_display_dispatch_pending(g_state.display);
+        }
+
+        pollfd fds[2] = {{.fd = wl_display_get_fd(g_state.display), .events = POLLIN}, {.fd = timerFD, .events = POLLIN}};
+
+        if (wl_display_flush(g_state.display) < 0 && errno == EAGAIN)
+            fds[0].events |= POLLOUT;
+
+        const auto TIMEOUTMS = std::chrono::duration_cast<std::chrono::milliseconds>((g_state.measuring ? END : WARMUPEND) - NOW).count() + 1;
+
+        if (poll(fds, timerFD >= 0 ? 2 : 1, TIMEOUTMS) < 0 && errno != EINTR)
+            fail("poll failed");
+
+        if (fds[0].revents & POLLIN) {
+            if (wl_display_read_events(g_state.display) < 0)
+                fail("lost the connection to the compositor");
+        } else
+            wl_display_cancel_read(g_state.display);
+
+        if (fds[0].revents & (POLLERR | POLLHUP))
+            fail("lost the connection to the compositor");
+
+        wl_display_dispatch_pending(g_state.display);
+
+        if (timerFD >= 0 && (fds[1].revents & POLLIN)) {
+            uint64_t expirations = 0;
+            read(timerFD, &expirations, sizeof(expirations));
+
+            for (auto& t : g_state.toplevels) {
+                commitToplevel(t.get());
+            }
+        }
+    }
+
+    const float SECONDS      = std::chrono::duration<float>(std::chrono::steady_clock::now() - measuringStart).count();
+    const float CPUMS        = (compositorCPUTicks(peer.pid) - cpuTicksStart) * 1000.F / sysconf(_SC_CLK_TCK);
+    const float CPUPERCOMMIT = g_state.commits == 0 ? 0 : CPUMS * 1000.F / g_state.commits;
+
+    const float P50 = percentile(g_state.latenciesMs, 0.5F);
+    const float P95 = percentile(g_state.latenciesMs, 0.95F);
+    const float P99 = percentile(g_state.latenciesMs, 0.99F);
+    const float MAX = g_state.latenciesMs.empty() ? 0 : *std::ranges::max_element(g_state.latenciesMs);
+
+    if (g_options.json) {
+        std::println(R"#({{"toplevels": {}, "subsurfaces": {}, "buffer": "{}", "seconds": {:.3f}, "commits": {}, "buffersCreated": {}, "commitsPerSecond": {:.1f}, )#"
+                     R"#("frameCallbacks": {}, "latencyMs": {{"p50": {:.3f}, "p95": {:.3f}, "p99": {:.3f}, "max": {:.3f}}}, "compositorCpuMs": {:.1f}, "compositorCpuUsPerCommit": {:.3f}}})#",
+                     g_options.toplevels, g_options.subsurfaces, g_options.dmabuf ? "dmabuf" : "shm", SECONDS, g_state.commits, g_state.buffers, g_state.commits / SECONDS,
+                     g_state.framesDone, P50, P95, P99, MAX, CPUMS, CPUPERCOMMIT);
+    } else {
+        std::println("{} toplevels with {} subsurfaces each, {} buffers, over {:.1f}s:", g_options.toplevels, g_options.subsurfaces, g_options.dmabuf ? "dmabuf" : "shm", SECONDS);
+        std::println("\tcommits: {} ({:.1f}/s), buffers created: {}", g_state.commits, g_state.commits / SECONDS, g_state.buffers);
+        std::println("\tcommit to frame callback: p50 {:.3f}ms p95 {:.3f}ms p99 {:.3f}ms max {:.3f}ms ({} callbacks)", P50, P95, P99, MAX, g_state.framesDone);
+        std::println("\tcompositor cpu: {:.1f}ms, {:.3f}us per commit", CPUMS, CPUPERCOMMIT);
+    }
+
+    wl_display_disconnect(g_state.display);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#!/bin/sh
+# Runs Hyprland on a headless output with software GL, opens a set of scripted
+# clients and prints render statistics (see hyprctl renderstats) as JSON.
+#
+# Needs a DRM render node for EGL; on CI runners without a GPU, load vgem or vkms
+# (modprobe vkms). Rendering itself goes through llvmpipe.
+#
+# Options are passed through the environment:
+#   HYPRLAND     Hyprland binary                      (default: ./build/Hyprland)
+#   FRAMES       frames to measure per monitor        (default: 600)
+#   WARMUP       frames to discard first              (default: 60)
+#   WINDOWS      number of clients                    (default: 4)
+#   DAMAGE       full | partial | egl                 (default: full)
+#   CLIENT       command overriding the DAMAGE client
+#   BLUR, ROUNDING, SHADOWS, ANIMATIONS  0 or 1       (default: 1)
+#   RESOLUTION   headless output mode                 (default: 1920x1080@60)
+#   OUTPUT       where to write the JSON              (default: stdout)
+
+HYPRLAND=${HYPRLAND-./build/Hyprland}
+FRAMES=${FRAMES-600}
+WARMUP=${WARMUP-60}
+WINDOWS=${WINDOWS-4}
+DAMAGE=${DAMAGE-full}
+BLUR=${BLUR-1}
+ROUNDING=${ROUNDING-1}
+SHADOWS=${SHADOWS-1}
+ANIMATIONS=${ANIMATIONS-1}
+RESOLUTION=${RESOLUTION-1920x1080@60}
+
+if [ -z "$CLIENT" ]; then
+    case "$DAMAGE" in
+        full) CLIENT=weston-simple-shm ;;
+        partial) CLIENT=weston-simple-damage ;;
+        egl) CLIENT=weston-simple-egl ;;
+        *)
+            echo "Unknown DAMAGE pattern $DAMAGE" >&2
+            exit 1
+            ;;
+    esac
+fi
+
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+[ "$ROUNDING" = "1" ] && ROUNDING_PX=10 || ROUNDING_PX=0
+
+cat >"$WORKDIR/hyprland.conf" <<EOF
+monitor = BENCH-1, $RESOLUTION, 0x0, 1
+
+exec-once = hyprctl output create headless BENCH-1
+
+decoration {
+    rounding = $ROUNDING_PX
+    shadow {
+        enabled = $SHADOWS
+    }
+    blur {
+        enabled = $BLUR
+    }
+}
+
+animations {
+    enabled = $ANIMATIONS
+}
+
+misc {
+    disable_hyprland_logo = 1
+    disable_splash_rendering = 1
+    disable_autoreload = 1
+}
+EOF
+
+i=0
+while [ "$i" -lt "$WINDOWS" ]; do
+    echo "exec-once = $CLIENT" >>"$WORKDIR/hyprland.conf"
+    i=$((i + 1))
+done
+
+export LIBGL_ALWAYS_SOFTWARE=1
+export HYPRLAND_BENCHMARK_FRAMES="$FRAMES"
+export HYPRLAND_BENCHMARK_WARMUP="$WARMUP"
+export HYPRLAND_BENCHMARK_OUTPUT="$WORKDIR/result.json"
+export XDG_RUNTIME_DIR=${XDG_RUNTIME_DIR-$WORKDIR}
+unset WAYLAND_DISPLAY DISPLAY
+
+"$HYPRLAND" --config "$WORKDIR/hyprland.conf" >"$WORKDIR/hyprland.log" 2>&1
+
+if [ ! -s "$WORKDIR/result.json" ]; then
+    echo "Benchmark did not finish, log follows" >&2
+    cat "$WORKDIR/hyprland.log" >&2
+    exit 1
+fi
+
+if [ -n "$OUTPUT" ]; then
+    cp "$WORKDIR/result.json" "$OUTPUT"
+else
+    cat "$WORKDIR/result.json"
+fi
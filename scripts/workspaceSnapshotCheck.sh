@@ -0,0 +1,76 @@
+#!/bin/sh
+# Checks that animations:workspace_snapshots captures each workspace of a plain
+# slide exactly once. Runs Hyprland on a headless output with the default colors,
+# opens a client on workspaces 1 and 2, stops the clients so they can't commit,
+# switches workspace and reads the capture count from hyprctl renderstats.
+#
+# Same requirements as renderBenchmark.sh. Options are passed through the environment:
+#   HYPRLAND     Hyprland binary                      (default: ./build/Hyprland)
+#   HYPRCTL      hyprctl binary                       (default: ./build/hyprctl/hyprctl)
+#   CLIENT       client opened on both workspaces     (default: weston-simple-shm)
+
+HYPRLAND=$(realpath "${HYPRLAND-./build/Hyprland}")
+HYPRCTL=$(realpath "${HYPRCTL-./build/hyprctl/hyprctl}")
+CLIENT=${CLIENT-weston-simple-shm}
+
+WORKDIR=$(mktemp -d)
+HYPRLAND_PID=
+trap '[ -n "$HYPRLAND_PID" ] && kill "$HYPRLAND_PID" 2>/dev/null; rm -rf "$WORKDIR"' EXIT
+
+cat >"$WORKDIR/hyprland.conf" <<EOF
+monitor = CHECK-1, 1920x1080@60, 0x0, 1
+
+exec-once = $HYPRCTL output create headless CHECK-1
+exec-once = [workspace 1 silent] $CLIENT
+exec-once = [workspace 2 silent] $CLIENT
+
+animations {
+    enabled = 1
+    workspace_snapshots = 1
+}
+
+misc {
+    disable_hyprland_logo = 1
+    disable_splash_rendering = 1
+    disable_autoreload = 1
+}
+EOF
+
+fail() {
+    echo "$1" >&2
+    cat "$WORKDIR/hyprland.log" >&2
+    exit 1
+}
+
+export LIBGL_ALWAYS_SOFTWARE=1
+export XDG_RUNTIME_DIR=${XDG_RUNTIME_DIR-$WORKDIR}
+unset WAYLAND_DISPLAY DISPLAY HYPRLAND_INSTANCE_SIGNATURE
+
+"$HYPRLAND" --config "$WORKDIR/hyprland.conf" >"$WORKDIR/hyprland.log" 2>&1 &
+HYPRLAND_PID=$!
+
+# wait for both clients to map
+i=0
+while [ "$("$HYPRCTL" -i 0 -j clients 2>/dev/null | grep -c '"pid"')" -lt 2 ]; do
+    i=$((i + 1))
+    [ "$i" -gt 100 ] && fail "Clients didn't map, log follows"
+    sleep 0.2
+done
+
+# from here on only the compositor can dirty the snapshots
+for pid in $("$HYPRCTL" -i 0 -j clients | sed -n 's/.*"pid": \([0-9]*\).*/\1/p'); do
+    kill -STOP "$pid"
+done
+sleep 1
+
+"$HYPRCTL" -i 0 renderstats reset >/dev/null
+"$HYPRCTL" -i 0 dispatch workspace 2 >/dev/null
+sleep 2
+
+CAPTURES=$("$HYPRCTL" -i 0 -j renderstats | sed -n 's/.*"workspaceSnapshots": \([0-9]*\).*/\1/p')
+
+if [ "$CAPTURES" != "2" ]; then
+    fail "Expected 2 workspace snapshots for one switch, got ${CAPTURES:-none}, log follows"
+fi
+
+echo "ok: each workspace was captured once"
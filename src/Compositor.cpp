@@ -6,6 +6,7 @@
 #include "managers/TokenManager.hpp"
 #include "managers/PointerManager.hpp"
 #include "managers/SeatManager.hpp"
+#include "managers/input/KeymapCache.hpp"
 #include "managers/VersionKeeperManager.hpp"
 #include "managers/eventLoop/EventLoopManager.hpp"
 #include <aquamarine/output/Output.hpp>
@@ -18,6 +19,7 @@
 #include <unordered_set>
 #include "debug/HyprCtl.hpp"
 #include "debug/CrashReporter.hpp"
+#include "debug/RenderStats.hpp"
 #ifdef USES_SYSTEMD
 #include <helpers/SdDaemon.hpp> // for SdNotify
 #endif
@@ -527,6 +529,7 @@ void CCompositor::cleanup() {
     g_pPluginSystem.reset();
     g_pHyprNotificationOverlay.reset();
     g_pDebugOverlay.reset();
+    g_pRenderStats.reset();
     g_pEventManager.reset();
     g_pSessionLockManager.reset();
     g_pProtocolManager.reset();
@@ -539,6 +542,7 @@ void CCompositor::cleanup() {
     g_pConfigManager.reset();
     g_pAnimationManager.reset();
     g_pKeybindManager.reset();
+    g_pKeymapCache.reset();
     g_pHookSystem.reset();
     g_pWatchdog.reset();
     g_pXWaylandManager.reset();
@@ -616,6 +620,9 @@ void CCompositor::initManagers(eManagersInitStage stage) {
             Debug::log(LOG, "Creating CHyprCtl");
             g_pHyprCtl = std::make_unique<CHyprCtl>();
 
+            Debug::log(LOG, "Creating the KeymapCache!");
+            g_pKeymapCache = std::make_unique<CKeymapCache>();
+
             Debug::log(LOG, "Creating the InputManager!");
             g_pInputManager = std::make_unique<CInputManager>();
 
@@ -631,6 +638,9 @@ void CCompositor::initManagers(eManagersInitStage stage) {
             Debug::log(LOG, "Creating the HyprDebugOverlay!");
             g_pDebugOverlay = std::make_unique<CHyprDebugOverlay>();
 
+            Debug::log(LOG, "Creating the RenderStats!");
+            g_pRenderStats = std::make_unique<CRenderStats>();
+
             Debug::log(LOG, "Creating the HyprNotificationOverlay!");
             g_pHyprNotificationOverlay = std::make_unique<CHyprNotificationOverlay>();
 
@@ -798,6 +808,9 @@ void CCompositor::removeWindowFromVectorSafe(PHLWINDOW pWindow) {
     if (!pWindow->m_bFadingOut) {
         EMIT_HOOK_EVENT("destroyWindow", pWindow);
 
+        if (pWindow->m_pWorkspace)
+            pWindow->m_pWorkspace->removeWindow(pWindow);
+
         std::erase_if(m_vWindows, [&](SP<CWindow>& el) { return el == pWindow; });
         std::erase_if(m_vWindowsFadingOut, [&](PHLWINDOWREF el) { return el.lock() == pWindow; });
     }
@@ -818,7 +831,8 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
     static auto PBORDERSIZE       = CConfigValue<Hyprlang::INT>("general:border_size");
     static auto PBORDERGRABEXTEND = CConfigValue<Hyprlang::INT>("general:extend_border_grab_area");
     static auto PSPECIALFALLTHRU  = CConfigValue<Hyprlang::INT>("input:special_fallthrough");
-    const auto  BORDER_GRAB_AREA  = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
+    static auto PBORDERGRABAREA   = CDerivedConfigValue<int64_t>([] { return *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0; });
+    const auto  BORDER_GRAB_AREA  = *PBORDERGRABAREA;
 
     // pinned windows on top of floating regardless
     if (properties & ALLOW_FLOATING) {
@@ -1087,7 +1101,7 @@ void CCompositor::focusWindow(PHLWINDOW pWindow, SP<CWLSurfaceResource> pSurface
         return;
 
     if (pWindow->m_bPinned)
-        pWindow->m_pWorkspace = m_pLastMonitor->activeWorkspace;
+        pWindow->setWorkspace(m_pLastMonitor->activeWorkspace);
 
     const auto PMONITOR = pWindow->m_pMonitor.lock();
 
@@ -1925,7 +1939,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_vWindows) {
         if (w->m_pWorkspace == PWORKSPACEA) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = PWORKSPACEB;
+                w->setWorkspace(PWORKSPACEB);
                 continue;
             }
 
@@ -1950,7 +1964,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_vWindows) {
         if (w->m_pWorkspace == PWORKSPACEB) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = PWORKSPACEA;
+                w->setWorkspace(PWORKSPACEA);
                 continue;
             }
 
@@ -2125,7 +2139,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, PHLMONITOR pMo
     for (auto const& w : m_vWindows) {
         if (w->m_pWorkspace == pWorkspace) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID);
+                w->setWorkspace(g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID));
                 continue;
             }
 
@@ -2257,7 +2271,6 @@ void CCompositor::setWindowFullscreenClient(const PHLWINDOW PWINDOW, const eFull
 }
 
 void CCompositor::setWindowFullscreenState(const PHLWINDOW PWINDOW, SFullscreenState state) {
-    static auto PDIRECTSCANOUT      = CConfigValue<Hyprlang::INT>("render:direct_scanout");
     static auto PALLOWPINFULLSCREEN = CConfigValue<Hyprlang::INT>("binds:allow_pin_fullscreen");
 
     if (!validMapped(PWINDOW) || g_pCompositor->m_bUnsafeState)
@@ -2332,10 +2345,7 @@ void CCompositor::setWindowFullscreenState(const PHLWINDOW PWINDOW, SFullscreenS
     if (!PMONITOR)
         return;
 
-    // send a scanout tranche if we are entering fullscreen, and send a regular one if we aren't.
-    // ignore if DS is disabled.
-    if (*PDIRECTSCANOUT)
-        g_pHyprRenderer->setSurfaceScanoutMode(PWINDOW->m_pWLSurface->resource(), EFFECTIVE_MODE != FSMODE_NONE ? PMONITOR->self.lock() : nullptr);
+    // scanout tranches are handled by CHyprRenderer::updateScanoutFeedback, once the window actually qualifies
 
     g_pConfigManager->ensureVRR(PMONITOR);
 }
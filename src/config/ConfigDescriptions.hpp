@@ -360,6 +360,13 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{true},
     },
+    SConfigOptionDescription{
+        .value       = "animations:workspace_snapshots",
+        .description = "draw sliding workspaces from a snapshot that is only redrawn when their windows change. Windows are captured without blur, and keep their dim and "
+                       "opacity from the start of the slide. Workspaces with overlapping windows or dim_around are drawn normally.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
 
     /*
      * input:
@@ -446,6 +453,13 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{false},
     },
+    SConfigOptionDescription{
+        .value       = "input:coalesce_motion",
+        .description = "Deliver pointer motion to the focused client immediately, but only re-evaluate focus, hover and cursor shape once per event loop iteration. Useful "
+                       "with high polling rate mice.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
     SConfigOptionDescription{
         .value       = "input:left_handed",
         .description = "Switches RMB and LMB",
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <sstream>
 #include <ranges>
+#include <typeindex>
 #include <unordered_set>
 #include <hyprutils/string/String.hpp>
 #include <filesystem>
@@ -486,6 +487,7 @@ CConfigManager::CConfigManager() {
 
     m_pConfig->addConfigValue("animations:enabled", Hyprlang::INT{1});
     m_pConfig->addConfigValue("animations:first_launch_animation", Hyprlang::INT{1});
+    m_pConfig->addConfigValue("animations:workspace_snapshots", Hyprlang::INT{0});
 
     m_pConfig->addConfigValue("input:follow_mouse", Hyprlang::INT{1});
     m_pConfig->addConfigValue("input:focus_on_close", Hyprlang::INT{0});
@@ -506,6 +508,7 @@ CConfigManager::CConfigManager() {
     m_pConfig->addConfigValue("input:numlock_by_default", Hyprlang::INT{0});
     m_pConfig->addConfigValue("input:resolve_binds_by_sym", Hyprlang::INT{0});
     m_pConfig->addConfigValue("input:force_no_accel", Hyprlang::INT{0});
+    m_pConfig->addConfigValue("input:coalesce_motion", Hyprlang::INT{0});
     m_pConfig->addConfigValue("input:float_switch_override_focus", Hyprlang::INT{1});
     m_pConfig->addConfigValue("input:left_handed", Hyprlang::INT{0});
     m_pConfig->addConfigValue("input:scroll_method", {STRVAL_EMPTY});
@@ -613,40 +616,40 @@ CConfigManager::CConfigManager() {
 
     // devices
     m_pConfig->addSpecialCategory("device", {"name"});
-    m_pConfig->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_pConfig->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_pConfig->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_pConfig->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_pConfig->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "transform", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_pConfig->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    addDeviceConfigValue("sensitivity", {0.F});
+    addDeviceConfigValue("accel_profile", {STRVAL_EMPTY});
+    addDeviceConfigValue("kb_file", {STRVAL_EMPTY});
+    addDeviceConfigValue("kb_layout", {"us"});
+    addDeviceConfigValue("kb_variant", {STRVAL_EMPTY});
+    addDeviceConfigValue("kb_options", {STRVAL_EMPTY});
+    addDeviceConfigValue("kb_rules", {STRVAL_EMPTY});
+    addDeviceConfigValue("kb_model", {STRVAL_EMPTY});
+    addDeviceConfigValue("repeat_rate", Hyprlang::INT{25});
+    addDeviceConfigValue("repeat_delay", Hyprlang::INT{600});
+    addDeviceConfigValue("natural_scroll", Hyprlang::INT{0});
+    addDeviceConfigValue("tap_button_map", {STRVAL_EMPTY});
+    addDeviceConfigValue("numlock_by_default", Hyprlang::INT{0});
+    addDeviceConfigValue("resolve_binds_by_sym", Hyprlang::INT{0});
+    addDeviceConfigValue("disable_while_typing", Hyprlang::INT{1});
+    addDeviceConfigValue("clickfinger_behavior", Hyprlang::INT{0});
+    addDeviceConfigValue("middle_button_emulation", Hyprlang::INT{0});
+    addDeviceConfigValue("tap-to-click", Hyprlang::INT{1});
+    addDeviceConfigValue("tap-and-drag", Hyprlang::INT{1});
+    addDeviceConfigValue("drag_lock", Hyprlang::INT{0});
+    addDeviceConfigValue("left_handed", Hyprlang::INT{0});
+    addDeviceConfigValue("scroll_method", {STRVAL_EMPTY});
+    addDeviceConfigValue("scroll_button", Hyprlang::INT{0});
+    addDeviceConfigValue("scroll_button_lock", Hyprlang::INT{0});
+    addDeviceConfigValue("scroll_points", {STRVAL_EMPTY});
+    addDeviceConfigValue("transform", Hyprlang::INT{0});
+    addDeviceConfigValue("output", {STRVAL_EMPTY});
+    addDeviceConfigValue("enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    addDeviceConfigValue("region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    addDeviceConfigValue("absolute_region_position", Hyprlang::INT{0}); // only for tablets
+    addDeviceConfigValue("region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    addDeviceConfigValue("relative_input", Hyprlang::INT{0});           // only for tablets
+    addDeviceConfigValue("active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    addDeviceConfigValue("active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
 
     // keywords
     m_pConfig->registerHandler(&::handleRawExec, "exec", {false});
@@ -843,6 +846,7 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     m_mAdditionalReservedAreas.clear();
     m_dBlurLSNamespaces.clear();
     m_dWorkspaceRules.clear();
+    m_vWorkspaceRuleCache.clear();
     setDefaultAnimationVars(); // reset anims
     m_vDeclaredPlugins.clear();
     m_dLayerRules.clear();
@@ -860,10 +864,120 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     return RET;
 }
 
+static std::string stringifyConfigValue(Hyprlang::CConfigValue* value) {
+    if (!value)
+        return "unset";
+
+    const auto VAL  = value->getValue();
+    const auto TYPE = std::type_index(VAL.type());
+
+    if (TYPE == typeid(Hyprlang::INT))
+        return std::to_string(std::any_cast<Hyprlang::INT>(VAL));
+    else if (TYPE == typeid(Hyprlang::FLOAT))
+        return std::to_string(std::any_cast<Hyprlang::FLOAT>(VAL));
+    else if (TYPE == typeid(Hyprlang::VEC2))
+        return std::format("{},{}", std::any_cast<Hyprlang::VEC2>(VAL).x, std::any_cast<Hyprlang::VEC2>(VAL).y);
+    else if (TYPE == typeid(Hyprlang::STRING))
+        return std::any_cast<Hyprlang::STRING>(VAL);
+    else if (TYPE == typeid(void*))
+        return ((ICustomConfigValueData*)std::any_cast<void*>(VAL))->toString();
+
+    return "";
+}
+
+SConfigSnapshot CConfigManager::snapshotConfig() {
+    SConfigSnapshot snapshot;
+
+    // everything performMonitorReload reads: the rules, including full modelines, and the reserved areas applied by arrangeLayersForMonitor
+    for (auto const& r : m_dMonitorRules) {
+        const auto& MODE = r.drmMode;
+        snapshot.monitors += std::format("{}:{}:{}:{}:{}:{}:{}:{}:{}:{}:{}:", r.name, (int)r.autoDir, r.resolution, r.offset, r.scale, r.refreshRate, r.disabled,
+                                         (int)r.transform, r.mirrorOf, r.enable10bit, r.vrr.value_or(-1));
+        snapshot.monitors += std::format("{}:{} {} {} {} {}:{} {} {} {} {}:{}:{}:{}:{}\n", MODE.clock, MODE.hdisplay, MODE.hsync_start, MODE.hsync_end, MODE.htotal, MODE.hskew,
+                                         MODE.vdisplay, MODE.vsync_start, MODE.vsync_end, MODE.vtotal, MODE.vscan, MODE.vrefresh, MODE.flags, MODE.type,
+                                         std::string_view{MODE.name, strnlen(MODE.name, sizeof(MODE.name))});
+    }
+
+    std::vector<std::string> reserved;
+    for (auto const& [name, area] : m_mAdditionalReservedAreas) {
+        reserved.push_back(std::format("reserved:{}:{} {} {} {}\n", name, area.top, area.bottom, area.left, area.right));
+    }
+    std::ranges::sort(reserved);
+
+    for (auto const& r : reserved) {
+        snapshot.monitors += r;
+    }
+
+    snapshot.monitors += stringifyConfigValue(m_pConfig->getConfigValuePtr("misc:vrr"));
+    snapshot.monitors += stringifyConfigValue(m_pConfig->getConfigValuePtr("debug:disable_scale_checks"));
+
+    for (auto const& o : CONFIG_OPTIONS) {
+        if (!o.specialCategory.empty())
+            continue;
+
+        if (o.value.starts_with("input:"))
+            snapshot.input += o.value + "=" + stringifyConfigValue(m_pConfig->getConfigValuePtr(o.value.c_str())) + "\n";
+        else if (o.value.starts_with("group:"))
+            snapshot.groupbar += o.value + "=" + stringifyConfigValue(m_pConfig->getConfigValuePtr(o.value.c_str())) + "\n";
+    }
+
+    snapshot.groupbar += stringifyConfigValue(m_pConfig->getConfigValuePtr("misc:font_family"));
+
+    // the input manager doesn't exist yet during the first reload
+    if (!g_pInputManager)
+        return snapshot;
+
+    // devices plugged in later are configured when they appear, only the current ones matter here
+    std::vector<std::string> devices;
+    for (auto const& k : g_pInputManager->m_vKeyboards)
+        devices.push_back(k->hlName);
+    for (auto const& p : g_pInputManager->m_vPointers)
+        devices.push_back(p->hlName);
+    for (auto const& t : g_pInputManager->m_vTouches)
+        devices.push_back(t->hlName);
+    for (auto const& t : g_pInputManager->m_vTablets)
+        devices.push_back(t->hlName);
+    for (auto const& t : g_pInputManager->m_vTabletTools)
+        devices.push_back(t->hlName);
+    for (auto const& t : g_pInputManager->m_vTabletPads)
+        devices.push_back(t->hlName);
+
+    for (auto const& d : devices) {
+        if (!deviceConfigExists(d))
+            continue;
+
+        snapshot.input += "device:" + d + "\n";
+
+        for (auto const& k : m_vDeviceConfigKeys) {
+            snapshot.input += k + "=" + stringifyConfigValue(m_pConfig->getSpecialConfigValuePtr("device", k.c_str(), d.c_str())) + "\n";
+        }
+    }
+
+    return snapshot;
+}
+
 void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     static const auto PENABLEEXPLICIT     = CConfigValue<Hyprlang::INT>("render:explicit_sync");
     static int        prevEnabledExplicit = *PENABLEEXPLICIT;
 
+    m_iConfigGeneration++;
+
+    // apply only what changed since the last reload, unless something was set in between (e.g. with hyprctl keyword).
+    // The first launch applies everything and leaves no snapshot, devices and monitors don't exist yet
+    const bool FULLAPPLY       = isFirstLaunch || !m_sAppliedSnapshot.has_value();
+    const auto SNAPSHOT        = isFirstLaunch ? SConfigSnapshot{} : snapshotConfig();
+    const bool MONITORSCHANGED = FULLAPPLY || SNAPSHOT.monitors != m_sAppliedSnapshot->monitors;
+    const bool INPUTCHANGED    = FULLAPPLY || SNAPSHOT.input != m_sAppliedSnapshot->input;
+    const bool GROUPBARCHANGED = FULLAPPLY || SNAPSHOT.groupbar != m_sAppliedSnapshot->groupbar;
+
+    if (isFirstLaunch)
+        m_sAppliedSnapshot.reset();
+    else
+        m_sAppliedSnapshot = SNAPSHOT;
+
+    Debug::log(LOG, "Config reload: monitors {}, input {}, groupbar {}", MONITORSCHANGED ? "changed" : "unchanged", INPUTCHANGED ? "changed" : "unchanged",
+               GROUPBARCHANGED ? "changed" : "unchanged");
+
     for (auto const& w : g_pCompositor->m_vWindows) {
         w->uncacheWindowDecos();
     }
@@ -872,7 +986,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
-    if (!isFirstLaunch) {
+    if (!isFirstLaunch && INPUTCHANGED) {
         g_pInputManager->setKeyboardLayout();
         g_pInputManager->setPointerConfigs();
         g_pInputManager->setTouchDeviceConfigs();
@@ -905,7 +1019,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     // not on first launch because monitors might not exist yet
     // and they'll be taken care of in the newMonitor event
     // ignore if nomonitorreload is set
-    if (!isFirstLaunch && !m_bNoMonitorReload) {
+    if (!isFirstLaunch && !m_bNoMonitorReload && (MONITORSCHANGED || m_bWantsMonitorReload)) {
         // check
         performMonitorReload();
         ensureMonitorStatus();
@@ -935,7 +1049,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
         g_pCompositor->m_bEnableXwayland = PENABLEXWAYLAND;
 #endif
 
-    if (!isFirstLaunch && !g_pCompositor->m_bUnsafeState)
+    if (!isFirstLaunch && !g_pCompositor->m_bUnsafeState && GROUPBARCHANGED)
         refreshGroupBarGradients();
 
     // Updates dynamic window and workspace rules
@@ -1015,6 +1129,11 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
 
     const auto        RET = m_pConfig->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
+    m_iConfigGeneration++;
+
+    // the live state no longer matches the last reload
+    m_sAppliedSnapshot.reset();
+
     // invalidate layouts if they changed
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
         for (auto const& m : g_pCompositor->m_vMonitors)
@@ -1031,6 +1150,10 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
     // Update window border colors
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
+    // decoration flags can depend on the changed value (e.g. general:border_part_of_window)
+    if (g_pDecorationPositioner)
+        g_pDecorationPositioner->invalidateAll();
+
     // manual crash
     if (std::any_cast<Hyprlang::INT>(m_pConfig->getConfigValue("debug:manual_crash")) && !m_bManualCrashInitiated) {
         m_bManualCrashInitiated = true;
@@ -1071,6 +1194,10 @@ void CConfigManager::tick() {
     }
 
     if (parse) {
+        // a forced reload (hyprctl reload, plugins) re-applies everything
+        if (m_bForceReload)
+            m_sAppliedSnapshot.reset();
+
         m_bForceReload = false;
 
         reload();
@@ -1088,6 +1215,11 @@ Hyprlang::CConfigValue* CConfigManager::getConfigValueSafeDevice(const std::stri
     return VAL;
 }
 
+void CConfigManager::addDeviceConfigValue(const char* name, const Hyprlang::CConfigValue& value) {
+    m_pConfig->addSpecialConfigValue("device", name, value);
+    m_vDeviceConfigKeys.emplace_back(name);
+}
+
 int CConfigManager::getDeviceInt(const std::string& dev, const std::string& v, const std::string& fallback) {
     return std::any_cast<Hyprlang::INT>(getConfigValueSafeDevice(dev, v, fallback)->getValue());
 }
@@ -1176,14 +1308,33 @@ SMonitorRule CConfigManager::getMonitorRuleFor(const PHLMONITOR PMONITOR) {
 }
 
 SWorkspaceRule CConfigManager::getWorkspaceRuleFor(PHLWORKSPACE pWorkspace) {
-    SWorkspaceRule mergedRule{};
-    for (auto const& rule : m_dWorkspaceRules) {
-        if (!pWorkspace->matchesStaticSelector(rule.workspaceString))
+    auto& matches = m_vWorkspaceRuleMatches;
+    matches.clear();
+
+    for (size_t i = 0; i < m_dWorkspaceRules.size(); ++i) {
+        const auto& RULE = m_dWorkspaceRules[i];
+        if (!(RULE.selector ? RULE.selector->matches(pWorkspace.get()) : pWorkspace->matchesStaticSelector(RULE.workspaceString)))
             continue;
 
-        mergedRule = mergeWorkspaceRules(mergedRule, rule);
+        matches.push_back(i);
+    }
+
+    // the merged rule only depends on which rules matched, most workspaces share a handful of these
+    for (auto const& [key, rule] : m_vWorkspaceRuleCache) {
+        if (key == matches)
+            return rule;
+    }
+
+    SWorkspaceRule mergedRule{};
+    for (auto const& i : matches) {
+        mergedRule = mergeWorkspaceRules(mergedRule, m_dWorkspaceRules[i]);
     }
 
+    if (m_vWorkspaceRuleCache.size() >= 32)
+        m_vWorkspaceRuleCache.clear();
+
+    m_vWorkspaceRuleCache.emplace_back(matches, mergedRule);
+
     return mergedRule;
 }
 
@@ -1192,8 +1343,10 @@ SWorkspaceRule CConfigManager::mergeWorkspaceRules(const SWorkspaceRule& rule1,
 
     if (rule1.monitor.empty())
         mergedRule.monitor = rule2.monitor;
-    if (rule1.workspaceString.empty())
+    if (rule1.workspaceString.empty()) {
         mergedRule.workspaceString = rule2.workspaceString;
+        mergedRule.selector        = rule2.selector;
+    }
     if (rule1.workspaceName.empty())
         mergedRule.workspaceName = rule2.workspaceName;
     if (rule1.workspaceId == WORKSPACE_INVALID)
@@ -1358,7 +1511,10 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(PHLWINDOW pWindow, boo
 
                 if (!rule.szOnWorkspace.empty()) {
                     const auto PWORKSPACE = pWindow->m_pWorkspace;
-                    if (!PWORKSPACE || !PWORKSPACE->matchesStaticSelector(rule.szOnWorkspace))
+                    if (!PWORKSPACE)
+                        continue;
+
+                    if (!(rule.onWorkspaceSelector ? rule.onWorkspaceSelector->matches(PWORKSPACE.get()) : PWORKSPACE->matchesStaticSelector(rule.szOnWorkspace)))
                         continue;
                 }
 
@@ -2040,8 +2196,10 @@ std::optional<std::string> CConfigManager::handleMonitor(const std::string& comm
             wsRule.workspaceString = ARGS[argno + 1];
             wsRule.workspaceId     = id;
             wsRule.workspaceName   = name;
+            wsRule.selector        = makeShared<CWorkspaceSelector>(wsRule.workspaceString);
 
             m_dWorkspaceRules.emplace_back(wsRule);
+            m_vWorkspaceRuleCache.clear();
             argno++;
         } else {
             Debug::log(ERR, "Config error: invalid monitor syntax at \"{}\"", ARGS[argno]);
@@ -2506,8 +2664,10 @@ std::optional<std::string> CConfigManager::handleWindowRuleV2(const std::string&
     if (FOCUSPOS != std::string::npos)
         rule.bFocus = extract(FOCUSPOS + 6) == "1" ? 1 : 0;
 
-    if (ONWORKSPACEPOS != std::string::npos)
-        rule.szOnWorkspace = extract(ONWORKSPACEPOS + 12);
+    if (ONWORKSPACEPOS != std::string::npos) {
+        rule.szOnWorkspace       = extract(ONWORKSPACEPOS + 12);
+        rule.onWorkspaceSelector = makeShared<CWorkspaceSelector>(rule.szOnWorkspace);
+    }
 
     if (RULE == "unset") {
         std::erase_if(m_dWindowRules, [&](const SWindowRule& other) {
@@ -2710,6 +2870,7 @@ std::optional<std::string> CConfigManager::handleWorkspaceRules(const std::strin
 
     wsRule.workspaceId   = id;
     wsRule.workspaceName = name;
+    wsRule.selector      = makeShared<CWorkspaceSelector>(wsRule.workspaceString);
 
     const auto IT = std::find_if(m_dWorkspaceRules.begin(), m_dWorkspaceRules.end(), [&](const auto& other) { return other.workspaceString == wsRule.workspaceString; });
 
@@ -2718,6 +2879,8 @@ std::optional<std::string> CConfigManager::handleWorkspaceRules(const std::strin
     else
         *IT = mergeWorkspaceRules(*IT, wsRule);
 
+    m_vWorkspaceRuleCache.clear();
+
     return {};
 }
 
@@ -2823,6 +2986,10 @@ const std::vector<SConfigOptionDescription>& CConfigManager::getAllDescriptions(
     return CONFIG_OPTIONS;
 }
 
+uint64_t CConfigManager::getConfigGeneration() {
+    return m_iConfigGeneration;
+}
+
 bool CConfigManager::shouldUseSoftwareCursors() {
     static auto PNOHW = CConfigValue<Hyprlang::INT>("cursor:no_hardware_cursors");
 
@@ -19,6 +19,7 @@
 #include "../helpers/varlist/VarList.hpp"
 #include "../desktop/Window.hpp"
 #include "../desktop/LayerSurface.hpp"
+#include "../desktop/WorkspaceSelector.hpp"
 
 #include "defaultConfig.hpp"
 #include "ConfigDataValues.hpp"
@@ -47,6 +48,7 @@ struct SWorkspaceRule {
     std::optional<std::string>         onCreatedEmptyRunCmd;
     std::optional<std::string>         defaultName;
     std::map<std::string, std::string> layoutopts;
+    SP<CWorkspaceSelector>             selector; // compiled workspaceString
 };
 
 struct SMonitorAdditionalReservedArea {
@@ -100,6 +102,11 @@ enum eConfigOptionFlags : uint8_t {
     CONFIG_OPTION_FLAG_PERCENTAGE = (1 << 0),
 };
 
+// what the costly parts of a reload read from the config, compared between reloads to skip the ones that didn't change
+struct SConfigSnapshot {
+    std::string monitors, input, groupbar;
+};
+
 struct SConfigOptionDescription {
 
     struct SBoolData {
@@ -182,6 +189,9 @@ class CConfigManager {
 
     const std::vector<SConfigOptionDescription>&                    getAllDescriptions();
 
+    // bumped whenever config values may have changed, see CDerivedConfigValue
+    uint64_t                                                        getConfigGeneration();
+
     std::unordered_map<std::string, SMonitorAdditionalReservedArea> m_mAdditionalReservedAreas;
 
     std::unordered_map<std::string, SAnimationPropertyConfig>       getAnimationConfig();
@@ -290,6 +300,10 @@ class CConfigManager {
 
     bool                                                      isFirstLaunch = true; // For exec-once
 
+    std::optional<SConfigSnapshot>                            m_sAppliedSnapshot; // empty forces a full apply on the next reload
+    uint64_t                                                  m_iConfigGeneration = 1;
+    std::vector<std::string>                                  m_vDeviceConfigKeys;
+
     std::deque<SMonitorRule>                                  m_dMonitorRules;
     std::deque<SWorkspaceRule>                                m_dWorkspaceRules;
     std::deque<SWindowRule>                                   m_dWindowRules;
@@ -304,6 +318,10 @@ class CConfigManager {
     std::vector<std::pair<std::string, std::string>>          m_vFailedPluginConfigValues; // for plugin values of unloaded plugins
     std::string                                               m_szConfigErrors = "";
 
+    // merged workspace rules, keyed by the indices of the rules that matched. Cleared whenever m_dWorkspaceRules changes.
+    std::vector<std::pair<std::vector<size_t>, SWorkspaceRule>> m_vWorkspaceRuleCache;
+    std::vector<size_t>                                         m_vWorkspaceRuleMatches;
+
     // internal methods
     void                              setAnimForChildren(SAnimationPropertyConfig* const);
     void                              updateBlurredLS(const std::string&, const bool);
@@ -313,6 +331,8 @@ class CConfigManager {
     static std::optional<std::string> verifyConfigExists();
     void                              postConfigReload(const Hyprlang::CParseResult& result);
     void                              reload();
+    SConfigSnapshot                   snapshotConfig();
+    void                              addDeviceConfigValue(const char* name, const Hyprlang::CConfigValue& value);
     SWorkspaceRule                    mergeWorkspaceRules(const SWorkspaceRule&, const SWorkspaceRule&);
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <typeindex>
 #include <hyprlang.hpp>
@@ -71,4 +72,30 @@ template <>
 inline Hyprlang::CUSTOMTYPE CConfigValue<Hyprlang::CUSTOMTYPE>::operator*() const {
     RASSERT(false, "Impossible to implement operator* of CConfigValue<Hyprlang::CUSTOMTYPE>, use ptr()");
     return *ptr();
-}
\ No newline at end of file
+}
+
+// a value computed from config values, e.g. the blur radius from size and passes.
+// Recomputed on access only if the config changed since, so hot paths can keep it in a static.
+template <typename T>
+class CDerivedConfigValue {
+  public:
+    CDerivedConfigValue(std::function<T()> compute) : m_fnCompute(std::move(compute)) {
+        ;
+    }
+
+    const T& operator*() {
+        const auto GENERATION = g_pConfigManager->getConfigGeneration();
+
+        if (m_iGeneration != GENERATION) {
+            m_value       = m_fnCompute();
+            m_iGeneration = GENERATION;
+        }
+
+        return m_value;
+    }
+
+  private:
+    std::function<T()> m_fnCompute;
+    T                  m_value       = {};
+    uint64_t           m_iGeneration = 0;
+};
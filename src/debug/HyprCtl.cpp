@@ -15,6 +15,7 @@
 #include <sys/un.h>
 #include <unistd.h>
 #include <sys/poll.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <ranges>
 
@@ -36,9 +37,13 @@ using namespace Hyprutils::String;
 #include "../devices/ITouch.hpp"
 #include "../devices/Tablet.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
+#include "../protocols/LinuxDMABUF.hpp"
 #include "debug/RollingLogFollow.hpp"
+#include "debug/HyprCtlWriter.hpp"
+#include "debug/RenderStats.hpp"
 #include "config/ConfigManager.hpp"
 #include "helpers/MiscFunctions.hpp"
+#include "helpers/sync/SyncTimeline.hpp"
 #include "../version.h"
 
 static void trimTrailingComma(std::string& str) {
@@ -73,71 +78,86 @@ static std::string availableModesForOutput(PHLMONITOR pMonitor, eHyprCtlOutputFo
     return result;
 }
 
+static void writeMonitorJSON(PHLMONITOR m, CHyprCtlWriter& writer) {
+    const auto& STATE = m->output->state->state();
+
+    writer.beginObject();
+    writer.field("id", m->ID);
+    writer.field("name", m->szName);
+    writer.field("description", m->szShortDescription);
+    writer.field("make", m->output->make);
+    writer.field("model", m->output->model);
+    writer.field("serial", m->output->serial);
+    writer.field("width", (int)m->vecPixelSize.x);
+    writer.field("height", (int)m->vecPixelSize.y);
+    writer.field("refreshRate", (double)m->refreshRate, 5);
+    writer.field("x", (int)m->vecPosition.x);
+    writer.field("y", (int)m->vecPosition.y);
+    writer.beginObject("activeWorkspace");
+    writer.field("id", m->activeWorkspaceID());
+    writer.field("name", !m->activeWorkspace ? "" : m->activeWorkspace->m_szName);
+    writer.endObject();
+    writer.beginObject("specialWorkspace");
+    writer.field("id", m->activeSpecialWorkspaceID());
+    writer.field("name", m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_szName : "");
+    writer.endObject();
+    writer.beginArray("reserved");
+    writer.value((int)m->vecReservedTopLeft.x);
+    writer.value((int)m->vecReservedTopLeft.y);
+    writer.value((int)m->vecReservedBottomRight.x);
+    writer.value((int)m->vecReservedBottomRight.y);
+    writer.endArray();
+    writer.field("scale", (double)m->scale, 2);
+    writer.field("transform", (int)m->transform);
+    writer.field("focused", m == g_pCompositor->m_pLastMonitor);
+    writer.field("dpmsStatus", m->dpmsStatus);
+    writer.field("vrr", STATE.adaptiveSync);
+    writer.fieldHex("solitary", (uintptr_t)m->solitaryClient.get(), false);
+    writer.field("activelyTearing", m->tearingState.activelyTearing);
+    writer.fieldHex("directScanoutTo", (uintptr_t)m->lastScanout.get(), false);
+    writer.field("disabled", !m->m_bEnabled);
+    writer.field("currentFormat", formatToString(STATE.drmFormat));
+    writer.field("mirrorOf", m->pMirrorOf ? std::to_string(m->pMirrorOf->ID) : "none");
+    writer.beginArray("availableModes");
+    if (writer.wants("availableModes")) {
+        std::string mode;
+        for (auto const& mm : m->output->modes) {
+            mode.clear();
+            std::format_to(std::back_inserter(mode), "{}x{}@{:.2f}Hz", mm->pixelSize.x, mm->pixelSize.y, mm->refreshRate / 1000.0);
+            writer.value(mode);
+        }
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+static void writeMonitorPlain(PHLMONITOR m, std::string& out) {
+    std::format_to(std::back_inserter(out),
+                   "Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
+                   "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
+                   "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tactivelyTearing: {}\n\tdirectScanoutTo: {:x}\n\tdisabled: {}\n\tcurrentFormat: {}\n\tmirrorOf: "
+                   "{}\n\tavailableModes: {}\n\n",
+                   m->szName, m->ID, (int)m->vecPixelSize.x, (int)m->vecPixelSize.y, m->refreshRate, (int)m->vecPosition.x, (int)m->vecPosition.y, m->szShortDescription,
+                   m->output->make, m->output->model, m->output->serial, m->activeWorkspaceID(), (!m->activeWorkspace ? "" : m->activeWorkspace->m_szName),
+                   m->activeSpecialWorkspaceID(), (m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_szName : ""), (int)m->vecReservedTopLeft.x,
+                   (int)m->vecReservedTopLeft.y, (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y, m->scale, (int)m->transform,
+                   (m == g_pCompositor->m_pLastMonitor ? "yes" : "no"), (int)m->dpmsStatus, m->output->state->state().adaptiveSync, (uint64_t)m->solitaryClient.get(),
+                   m->tearingState.activelyTearing, (uint64_t)m->lastScanout.get(), !m->m_bEnabled, formatToString(m->output->state->state().drmFormat),
+                   m->pMirrorOf ? std::format("{}", m->pMirrorOf->ID) : "none", availableModesForOutput(m, FORMAT_NORMAL));
+}
+
 std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
     std::string result;
     if (!m->output || m->ID == -1)
         return "";
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-
-        result += std::format(
-            R"#({{
-    "id": {},
-    "name": "{}",
-    "description": "{}",
-    "make": "{}",
-    "model": "{}",
-    "serial": "{}",
-    "width": {},
-    "height": {},
-    "refreshRate": {:.5f},
-    "x": {},
-    "y": {},
-    "activeWorkspace": {{
-        "id": {},
-        "name": "{}"
-    }},
-    "specialWorkspace": {{
-        "id": {},
-        "name": "{}"
-    }},
-    "reserved": [{}, {}, {}, {}],
-    "scale": {:.2f},
-    "transform": {},
-    "focused": {},
-    "dpmsStatus": {},
-    "vrr": {},
-    "solitary": "{:x}",
-    "activelyTearing": {},
-    "directScanoutTo": "{:x}",
-    "disabled": {},
-    "currentFormat": "{}",
-    "mirrorOf": "{}",
-    "availableModes": [{}]
-}},)#",
-
-            m->ID, escapeJSONStrings(m->szName), escapeJSONStrings(m->szShortDescription), escapeJSONStrings(m->output->make), escapeJSONStrings(m->output->model),
-            escapeJSONStrings(m->output->serial), (int)m->vecPixelSize.x, (int)m->vecPixelSize.y, m->refreshRate, (int)m->vecPosition.x, (int)m->vecPosition.y,
-            m->activeWorkspaceID(), (!m->activeWorkspace ? "" : escapeJSONStrings(m->activeWorkspace->m_szName)), m->activeSpecialWorkspaceID(),
-            escapeJSONStrings(m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_szName : ""), (int)m->vecReservedTopLeft.x, (int)m->vecReservedTopLeft.y,
-            (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y, m->scale, (int)m->transform, (m == g_pCompositor->m_pLastMonitor ? "true" : "false"),
-            (m->dpmsStatus ? "true" : "false"), (m->output->state->state().adaptiveSync ? "true" : "false"), (uint64_t)m->solitaryClient.get(),
-            (m->tearingState.activelyTearing ? "true" : "false"), (uint64_t)m->lastScanout.get(), (m->m_bEnabled ? "false" : "true"),
-            formatToString(m->output->state->state().drmFormat), m->pMirrorOf ? std::format("{}", m->pMirrorOf->ID) : "none", availableModesForOutput(m, format));
-
-    } else {
-        result += std::format("Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
-                              "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
-                              "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tactivelyTearing: {}\n\tdirectScanoutTo: {:x}\n\tdisabled: {}\n\tcurrentFormat: {}\n\tmirrorOf: "
-                              "{}\n\tavailableModes: {}\n\n",
-                              m->szName, m->ID, (int)m->vecPixelSize.x, (int)m->vecPixelSize.y, m->refreshRate, (int)m->vecPosition.x, (int)m->vecPosition.y, m->szShortDescription,
-                              m->output->make, m->output->model, m->output->serial, m->activeWorkspaceID(), (!m->activeWorkspace ? "" : m->activeWorkspace->m_szName),
-                              m->activeSpecialWorkspaceID(), (m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_szName : ""), (int)m->vecReservedTopLeft.x,
-                              (int)m->vecReservedTopLeft.y, (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y, m->scale, (int)m->transform,
-                              (m == g_pCompositor->m_pLastMonitor ? "yes" : "no"), (int)m->dpmsStatus, m->output->state->state().adaptiveSync, (uint64_t)m->solitaryClient.get(),
-                              m->tearingState.activelyTearing, (uint64_t)m->lastScanout.get(), !m->m_bEnabled, formatToString(m->output->state->state().drmFormat),
-                              m->pMirrorOf ? std::format("{}", m->pMirrorOf->ID) : "none", availableModesForOutput(m, format));
-    }
+        CHyprCtlWriter writer(result);
+        writeMonitorJSON(m, writer);
+        // kept for compatibility with callers that join entries themselves
+        result += ',';
+    } else
+        writeMonitorPlain(m, result);
 
     return result;
 }
@@ -152,170 +172,210 @@ std::string monitorsRequest(eHyprCtlOutputFormat format, std::string request) {
     if (vars.size() == 2 && vars[1] == "all")
         allMonitors = true;
 
-    std::string result = "";
+    auto& result = g_pHyprCtl->m_replyBuffer;
+    result.clear();
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginArray();
 
         for (auto const& m : allMonitors ? g_pCompositor->m_vRealMonitors : g_pCompositor->m_vMonitors) {
-            result += CHyprCtl::getMonitorData(m, format);
-        }
+            if (!m->output || m->ID == -1)
+                continue;
 
-        trimTrailingComma(result);
+            writeMonitorJSON(m, writer);
+        }
 
-        result += "]";
+        writer.endArray();
     } else {
         for (auto const& m : allMonitors ? g_pCompositor->m_vRealMonitors : g_pCompositor->m_vMonitors) {
             if (!m->output || m->ID == -1)
                 continue;
 
-            result += CHyprCtl::getMonitorData(m, format);
+            writeMonitorPlain(m, result);
         }
     }
 
-    return result;
+    return std::move(result);
 }
 
-static std::string getTagsData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    const auto tags = w->m_tags.getTags();
+static int getFocusHistoryID(PHLWINDOW wnd) {
+    for (size_t i = 0; i < g_pCompositor->m_vWindowFocusHistory.size(); ++i) {
+        if (g_pCompositor->m_vWindowFocusHistory[i].lock() == wnd)
+            return i;
+    }
+    return -1;
+}
 
-    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
-        return std::accumulate(tags.begin(), tags.end(), std::string(),
-                               [](const std::string& a, const std::string& b) { return a.empty() ? std::format("\"{}\"", b) : std::format("{}, \"{}\"", a, b); });
-    else
-        return std::accumulate(tags.begin(), tags.end(), std::string(), [](const std::string& a, const std::string& b) { return a.empty() ? b : a + ", " + b; });
+static std::string getTagsData(PHLWINDOW w) {
+    const auto tags = w->m_tags.getTags();
+    return std::accumulate(tags.begin(), tags.end(), std::string(), [](const std::string& a, const std::string& b) { return a.empty() ? b : a + ", " + b; });
 }
 
-static std::string getGroupedData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    const bool isJson = format == eHyprCtlOutputFormat::FORMAT_JSON;
+static std::string getGroupedData(PHLWINDOW w) {
     if (w->m_sGroupData.pNextWindow.expired())
-        return isJson ? "" : "0";
+        return "0";
 
-    std::ostringstream result;
+    std::string result;
 
-    PHLWINDOW          head = w->getGroupHead();
-    PHLWINDOW          curr = head;
+    PHLWINDOW   head = w->getGroupHead();
+    PHLWINDOW   curr = head;
     while (true) {
-        if (isJson)
-            result << std::format("\"0x{:x}\"", (uintptr_t)curr.get());
-        else
-            result << std::format("{:x}", (uintptr_t)curr.get());
+        std::format_to(std::back_inserter(result), "{:x}", (uintptr_t)curr.get());
         curr = curr->m_sGroupData.pNextWindow.lock();
         // We've wrapped around to the start, break out without trailing comma
         if (curr == head)
             break;
-        result << (isJson ? ", " : ",");
+        result += ',';
+    }
+
+    return result;
+}
+
+static void writeWindowJSON(PHLWINDOW w, CHyprCtlWriter& writer) {
+    writer.beginObject();
+    writer.fieldHex("address", (uintptr_t)w.get());
+    writer.field("mapped", w->m_bIsMapped);
+    writer.field("hidden", w->isHidden());
+    writer.beginArray("at");
+    writer.value((int)w->m_vRealPosition.goal().x);
+    writer.value((int)w->m_vRealPosition.goal().y);
+    writer.endArray();
+    writer.beginArray("size");
+    writer.value((int)w->m_vRealSize.goal().x);
+    writer.value((int)w->m_vRealSize.goal().y);
+    writer.endArray();
+    writer.beginObject("workspace");
+    writer.field("id", w->m_pWorkspace ? w->workspaceID() : WORKSPACE_INVALID);
+    writer.field("name", !w->m_pWorkspace ? "" : w->m_pWorkspace->m_szName);
+    writer.endObject();
+    writer.field("floating", w->m_bIsFloating);
+    writer.field("pseudo", w->m_bIsPseudotiled);
+    writer.field("monitor", (int64_t)w->monitorID());
+    writer.field("class", w->m_szClass);
+    writer.field("title", w->m_szTitle);
+    writer.field("initialClass", w->m_szInitialClass);
+    writer.field("initialTitle", w->m_szInitialTitle);
+    writer.field("pid", w->getPID());
+    writer.field("xwayland", w->m_bIsX11);
+    writer.field("pinned", w->m_bPinned);
+    writer.field("fullscreen", (uint8_t)w->m_sFullscreenState.internal);
+    writer.field("fullscreenClient", (uint8_t)w->m_sFullscreenState.client);
+    writer.beginArray("grouped");
+    if (!w->m_sGroupData.pNextWindow.expired() && writer.wants("grouped")) {
+        PHLWINDOW head = w->getGroupHead();
+        PHLWINDOW curr = head;
+        do {
+            writer.fieldHex({}, (uintptr_t)curr.get());
+            curr = curr->m_sGroupData.pNextWindow.lock();
+        } while (curr && curr != head);
     }
+    writer.endArray();
+    writer.beginArray("tags");
+    for (auto const& tag : w->m_tags.getTags()) {
+        writer.value(tag);
+    }
+    writer.endArray();
+    writer.fieldHex("swallowing", (uintptr_t)w->m_pSwallowed.lock().get());
+    if (writer.wants("focusHistoryID"))
+        writer.field("focusHistoryID", getFocusHistoryID(w));
+    writer.endObject();
+}
 
-    return result.str();
+static void writeWindowPlain(PHLWINDOW w, std::string& out) {
+    std::format_to(std::back_inserter(out),
+                   "Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: "
+                   "{}\n\ttitle: {}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
+                   "{}\n\txwayland: {}\n\tpinned: "
+                   "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: {}\n\ttags: {}\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\n",
+                   (uintptr_t)w.get(), w->m_szTitle, (int)w->m_bIsMapped, (int)w->isHidden(), (int)w->m_vRealPosition.goal().x, (int)w->m_vRealPosition.goal().y,
+                   (int)w->m_vRealSize.goal().x, (int)w->m_vRealSize.goal().y, w->m_pWorkspace ? w->workspaceID() : WORKSPACE_INVALID,
+                   (!w->m_pWorkspace ? "" : w->m_pWorkspace->m_szName), (int)w->m_bIsFloating, (int)w->m_bIsPseudotiled, (int64_t)w->monitorID(), w->m_szClass, w->m_szTitle,
+                   w->m_szInitialClass, w->m_szInitialTitle, w->getPID(), (int)w->m_bIsX11, (int)w->m_bPinned, (uint8_t)w->m_sFullscreenState.internal,
+                   (uint8_t)w->m_sFullscreenState.client, getGroupedData(w), getTagsData(w), (uintptr_t)w->m_pSwallowed.lock().get(), getFocusHistoryID(w));
 }
 
 std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
-        for (size_t i = 0; i < g_pCompositor->m_vWindowFocusHistory.size(); ++i) {
-            if (g_pCompositor->m_vWindowFocusHistory[i].lock() == wnd)
-                return i;
-        }
-        return -1;
-    };
+    std::string result;
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(
-            R"#({{
-    "address": "0x{:x}",
-    "mapped": {},
-    "hidden": {},
-    "at": [{}, {}],
-    "size": [{}, {}],
-    "workspace": {{
-        "id": {},
-        "name": "{}"
-    }},
-    "floating": {},
-    "pseudo": {},
-    "monitor": {},
-    "class": "{}",
-    "title": "{}",
-    "initialClass": "{}",
-    "initialTitle": "{}",
-    "pid": {},
-    "xwayland": {},
-    "pinned": {},
-    "fullscreen": {},
-    "fullscreenClient": {},
-    "grouped": [{}],
-    "tags": [{}],
-    "swallowing": "0x{:x}",
-    "focusHistoryID": {}
-}},)#",
-            (uintptr_t)w.get(), (w->m_bIsMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), (int)w->m_vRealPosition.goal().x, (int)w->m_vRealPosition.goal().y,
-            (int)w->m_vRealSize.goal().x, (int)w->m_vRealSize.goal().y, w->m_pWorkspace ? w->workspaceID() : WORKSPACE_INVALID,
-            escapeJSONStrings(!w->m_pWorkspace ? "" : w->m_pWorkspace->m_szName), ((int)w->m_bIsFloating == 1 ? "true" : "false"), (w->m_bIsPseudotiled ? "true" : "false"),
-            (int64_t)w->monitorID(), escapeJSONStrings(w->m_szClass), escapeJSONStrings(w->m_szTitle), escapeJSONStrings(w->m_szInitialClass),
-            escapeJSONStrings(w->m_szInitialTitle), w->getPID(), ((int)w->m_bIsX11 == 1 ? "true" : "false"), (w->m_bPinned ? "true" : "false"),
-            (uint8_t)w->m_sFullscreenState.internal, (uint8_t)w->m_sFullscreenState.client, getGroupedData(w, format), getTagsData(w, format),
-            (uintptr_t)w->m_pSwallowed.lock().get(), getFocusHistoryID(w));
-    } else {
-        return std::format(
-            "Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: {}\n\ttitle: "
-            "{}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
-            "{}\n\txwayland: {}\n\tpinned: "
-            "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: {}\n\ttags: {}\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\n",
-            (uintptr_t)w.get(), w->m_szTitle, (int)w->m_bIsMapped, (int)w->isHidden(), (int)w->m_vRealPosition.goal().x, (int)w->m_vRealPosition.goal().y,
-            (int)w->m_vRealSize.goal().x, (int)w->m_vRealSize.goal().y, w->m_pWorkspace ? w->workspaceID() : WORKSPACE_INVALID, (!w->m_pWorkspace ? "" : w->m_pWorkspace->m_szName),
-            (int)w->m_bIsFloating, (int)w->m_bIsPseudotiled, (int64_t)w->monitorID(), w->m_szClass, w->m_szTitle, w->m_szInitialClass, w->m_szInitialTitle, w->getPID(),
-            (int)w->m_bIsX11, (int)w->m_bPinned, (uint8_t)w->m_sFullscreenState.internal, (uint8_t)w->m_sFullscreenState.client, getGroupedData(w, format), getTagsData(w, format),
-            (uintptr_t)w->m_pSwallowed.lock().get(), getFocusHistoryID(w));
-    }
+        CHyprCtlWriter writer(result);
+        writeWindowJSON(w, writer);
+        // kept for compatibility with callers that join entries themselves
+        result += ',';
+    } else
+        writeWindowPlain(w, result);
+
+    return result;
 }
 
 std::string clientsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto& result = g_pHyprCtl->m_replyBuffer;
+    result.clear();
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginArray();
 
         for (auto const& w : g_pCompositor->m_vWindows) {
             if (!w->m_bIsMapped && !g_pHyprCtl->m_sCurrentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            writeWindowJSON(w, writer);
         }
 
-        trimTrailingComma(result);
-
-        result += "]";
+        writer.endArray();
     } else {
         for (auto const& w : g_pCompositor->m_vWindows) {
             if (!w->m_bIsMapped && !g_pHyprCtl->m_sCurrentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            writeWindowPlain(w, result);
         }
     }
-    return result;
+
+    return std::move(result);
 }
 
-std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format) {
+static void writeWorkspaceJSON(PHLWORKSPACE w, CHyprCtlWriter& writer) {
+    const auto PLASTW   = w->getLastFocusedWindow();
+    const auto PMONITOR = w->m_pMonitor.lock();
+
+    writer.beginObject();
+    writer.field("id", w->m_iID);
+    writer.field("name", w->m_szName);
+    writer.field("monitor", PMONITOR ? PMONITOR->szName : "?");
+    if (PMONITOR)
+        writer.field("monitorID", PMONITOR->ID);
+    else
+        writer.fieldRaw("monitorID", "null");
+    if (writer.wants("windows"))
+        writer.field("windows", w->getWindows());
+    writer.field("hasfullscreen", w->m_bHasFullscreenWindow);
+    writer.fieldHex("lastwindow", (uintptr_t)PLASTW.get());
+    writer.field("lastwindowtitle", PLASTW ? PLASTW->m_szTitle : "");
+    writer.endObject();
+}
+
+static void writeWorkspacePlain(PHLWORKSPACE w, std::string& out) {
     const auto PLASTW   = w->getLastFocusedWindow();
     const auto PMONITOR = w->m_pMonitor.lock();
+
+    std::format_to(std::back_inserter(out), "workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\n",
+                   w->m_iID, w->m_szName, PMONITOR ? PMONITOR->szName : "?", PMONITOR ? std::to_string(PMONITOR->ID) : "null", w->getWindows(), (int)w->m_bHasFullscreenWindow,
+                   (uintptr_t)PLASTW.get(), PLASTW ? PLASTW->m_szTitle : "");
+}
+
+std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format) {
+    std::string result;
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(R"#({{
-    "id": {},
-    "name": "{}",
-    "monitor": "{}",
-    "monitorID": {},
-    "windows": {},
-    "hasfullscreen": {},
-    "lastwindow": "0x{:x}",
-    "lastwindowtitle": "{}"
-}})#",
-                           w->m_iID, escapeJSONStrings(w->m_szName), escapeJSONStrings(PMONITOR ? PMONITOR->szName : "?"),
-                           escapeJSONStrings(PMONITOR ? std::to_string(PMONITOR->ID) : "null"), w->getWindows(), ((int)w->m_bHasFullscreenWindow == 1 ? "true" : "false"),
-                           (uintptr_t)PLASTW.get(), PLASTW ? escapeJSONStrings(PLASTW->m_szTitle) : "");
-    } else {
-        return std::format("workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\n", w->m_iID,
-                           w->m_szName, PMONITOR ? PMONITOR->szName : "?", PMONITOR ? std::to_string(PMONITOR->ID) : "null", w->getWindows(), (int)w->m_bHasFullscreenWindow,
-                           (uintptr_t)PLASTW.get(), PLASTW ? PLASTW->m_szTitle : "");
-    }
+        CHyprCtlWriter writer(result);
+        writeWorkspaceJSON(w, writer);
+    } else
+        writeWorkspacePlain(w, result);
+
+    return result;
 }
 
 static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputFormat format) {
@@ -371,34 +431,40 @@ std::string activeWorkspaceRequest(eHyprCtlOutputFormat format, std::string requ
     if (!g_pCompositor->m_pLastMonitor)
         return "unsafe state";
 
-    std::string result = "";
-    auto        w      = g_pCompositor->m_pLastMonitor->activeWorkspace;
+    auto w = g_pCompositor->m_pLastMonitor->activeWorkspace;
 
     if (!valid(w))
         return "internal error";
 
-    return CHyprCtl::getWorkspaceData(w, format);
+    if (format != eHyprCtlOutputFormat::FORMAT_JSON)
+        return CHyprCtl::getWorkspaceData(w, format);
+
+    std::string    result;
+    CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+    writeWorkspaceJSON(w, writer);
+    return result;
 }
 
 std::string workspacesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto& result = g_pHyprCtl->m_replyBuffer;
+    result.clear();
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginArray();
+
         for (auto const& w : g_pCompositor->m_vWorkspaces) {
-            result += CHyprCtl::getWorkspaceData(w, format);
-            result += ",";
+            writeWorkspaceJSON(w, writer);
         }
 
-        trimTrailingComma(result);
-        result += "]";
+        writer.endArray();
     } else {
         for (auto const& w : g_pCompositor->m_vWorkspaces) {
-            result += CHyprCtl::getWorkspaceData(w, format);
+            writeWorkspacePlain(w, result);
         }
     }
 
-    return result;
+    return std::move(result);
 }
 
 std::string workspaceRulesRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -427,10 +493,13 @@ std::string activeWindowRequest(eHyprCtlOutputFormat format, std::string request
     if (!validMapped(PWINDOW))
         return format == eHyprCtlOutputFormat::FORMAT_JSON ? "{}" : "Invalid";
 
-    auto result = CHyprCtl::getWindowData(PWINDOW, format);
+    std::string result;
 
-    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
-        result.pop_back();
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writeWindowJSON(PWINDOW, writer);
+    } else
+        writeWindowPlain(PWINDOW, result);
 
     return result;
 }
@@ -439,53 +508,37 @@ std::string layersRequest(eHyprCtlOutputFormat format, std::string request) {
     std::string result = "";
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "{\n";
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginObject();
 
         for (auto const& mon : g_pCompositor->m_vMonitors) {
-            result += std::format(
-                R"#("{}": {{
-    "levels": {{
-)#",
-                escapeJSONStrings(mon->szName));
+            writer.beginObject(mon->szName);
+            writer.beginObject("levels");
 
             int layerLevel = 0;
             for (auto const& level : mon->m_aLayerSurfaceLayers) {
-                result += std::format(
-                    R"#(
-        "{}": [
-)#",
-                    layerLevel);
+                writer.beginArray(std::to_string(layerLevel));
                 for (auto const& layer : level) {
-                    result += std::format(
-                        R"#(                {{
-                    "address": "0x{:x}",
-                    "x": {},
-                    "y": {},
-                    "w": {},
-                    "h": {},
-                    "namespace": "{}"
-                }},)#",
-                        (uintptr_t)layer.get(), layer->geometry.x, layer->geometry.y, layer->geometry.width, layer->geometry.height, escapeJSONStrings(layer->szNamespace));
+                    writer.beginObject();
+                    writer.fieldHex("address", (uintptr_t)layer.get());
+                    writer.field("x", layer->geometry.x);
+                    writer.field("y", layer->geometry.y);
+                    writer.field("w", layer->geometry.width);
+                    writer.field("h", layer->geometry.height);
+                    writer.field("namespace", layer->szNamespace);
+                    writer.endObject();
                 }
-
-                trimTrailingComma(result);
-
-                if (level.size() > 0)
-                    result += "\n        ";
-
-                result += "],";
+                writer.endArray();
 
                 layerLevel++;
             }
 
-            trimTrailingComma(result);
-
-            result += "\n    }\n},";
+            writer.endObject();
+            writer.endObject();
         }
 
-        trimTrailingComma(result);
-
-        result += "\n}\n";
+        writer.endObject();
+        result += '\n';
 
     } else {
         for (auto const& mon : g_pCompositor->m_vMonitors) {
@@ -567,113 +620,84 @@ std::string devicesRequest(eHyprCtlOutputFormat format, std::string request) {
     };
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "{\n";
-        result += "\"mice\": [\n";
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginObject();
 
+        writer.beginArray("mice");
         for (auto const& m : g_pInputManager->m_vPointers) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "name": "{}",
-        "defaultSpeed": {:.5f}
-    }},)#",
-                (uintptr_t)m.get(), escapeJSONStrings(m->hlName),
-                m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.f);
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)m.get());
+            writer.field("name", m->hlName);
+            writer.field("defaultSpeed", m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.0, 5);
+            writer.endObject();
         }
+        writer.endArray();
 
-        trimTrailingComma(result);
-        result += "\n],\n";
-
-        result += "\"keyboards\": [\n";
+        writer.beginArray("keyboards");
         for (auto const& k : g_pInputManager->m_vKeyboards) {
-            const auto KM = k->getActiveLayout();
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "name": "{}",
-        "rules": "{}",
-        "model": "{}",
-        "layout": "{}",
-        "variant": "{}",
-        "options": "{}",
-        "active_keymap": "{}",
-        "capsLock": {},
-        "numLock": {},
-        "main": {}
-    }},)#",
-                (uintptr_t)k.get(), escapeJSONStrings(k->hlName), escapeJSONStrings(k->currentRules.rules), escapeJSONStrings(k->currentRules.model),
-                escapeJSONStrings(k->currentRules.layout), escapeJSONStrings(k->currentRules.variant), escapeJSONStrings(k->currentRules.options), escapeJSONStrings(KM),
-                (getModState(k, XKB_MOD_NAME_CAPS) ? "true" : "false"), (getModState(k, XKB_MOD_NAME_NUM) ? "true" : "false"), (k->active ? "true" : "false"));
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)k.get());
+            writer.field("name", k->hlName);
+            writer.field("rules", k->currentRules.rules);
+            writer.field("model", k->currentRules.model);
+            writer.field("layout", k->currentRules.layout);
+            writer.field("variant", k->currentRules.variant);
+            writer.field("options", k->currentRules.options);
+            writer.field("active_keymap", k->getActiveLayout());
+            writer.field("capsLock", getModState(k, XKB_MOD_NAME_CAPS));
+            writer.field("numLock", getModState(k, XKB_MOD_NAME_NUM));
+            writer.field("main", k->active);
+            writer.endObject();
         }
+        writer.endArray();
 
-        trimTrailingComma(result);
-        result += "\n],\n";
-
-        result += "\"tablets\": [\n";
-
+        writer.beginArray("tablets");
         for (auto const& d : g_pInputManager->m_vTabletPads) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "type": "tabletPad",
-        "belongsTo": {{
-            "address": "0x{:x}",
-            "name": "{}"
-        }}
-    }},)#",
-                (uintptr_t)d.get(), (uintptr_t)d->parent.get(), escapeJSONStrings(d->parent ? d->parent->hlName : ""));
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)d.get());
+            writer.field("type", "tabletPad");
+            writer.beginObject("belongsTo");
+            writer.fieldHex("address", (uintptr_t)d->parent.get());
+            writer.field("name", d->parent ? d->parent->hlName : "");
+            writer.endObject();
+            writer.endObject();
         }
 
         for (auto const& d : g_pInputManager->m_vTablets) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "name": "{}"
-    }},)#",
-                (uintptr_t)d.get(), escapeJSONStrings(d->hlName));
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)d.get());
+            writer.field("name", d->hlName);
+            writer.endObject();
         }
 
         for (auto const& d : g_pInputManager->m_vTabletTools) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "type": "tabletTool",
-    }},)#",
-                (uintptr_t)d.get());
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)d.get());
+            writer.field("type", "tabletTool");
+            writer.endObject();
         }
+        writer.endArray();
 
-        trimTrailingComma(result);
-        result += "\n],\n";
-
-        result += "\"touch\": [\n";
-
+        writer.beginArray("touch");
         for (auto const& d : g_pInputManager->m_vTouches) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "name": "{}"
-    }},)#",
-                (uintptr_t)d.get(), escapeJSONStrings(d->hlName));
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)d.get());
+            writer.field("name", d->hlName);
+            writer.endObject();
         }
+        writer.endArray();
 
-        trimTrailingComma(result);
-        result += "\n],\n";
-
-        result += "\"switches\": [\n";
-
+        writer.beginArray("switches");
         for (auto const& d : g_pInputManager->m_lSwitches) {
-            result += std::format(
-                R"#(    {{
-        "address": "0x{:x}",
-        "name": "{}"
-    }},)#",
-                (uintptr_t)&d, escapeJSONStrings(d.pDevice ? d.pDevice->getName() : ""));
+            writer.beginObject();
+            writer.fieldHex("address", (uintptr_t)&d);
+            writer.field("name", d.pDevice ? d.pDevice->getName() : "");
+            writer.endObject();
         }
+        writer.endArray();
 
-        trimTrailingComma(result);
-        result += "\n]\n";
-
-        result += "}\n";
+        writer.endObject();
+        result += '\n';
 
     } else {
         result += "mice:\n";
@@ -1008,6 +1032,13 @@ std::string systemInfoRequest(eHyprCtlOutputFormat format, std::string request)
     } else
         result += "\tunknown: not runtime\n";
 
+    const auto& SYNC = CSyncTimeline::waiterStats();
+    result += "\nexplicit sync waiters:\n";
+    result += std::format("  added: {}, dispatched: {}, wakeups: {} ({} spurious), eventfds: {} created, {} reused\n", SYNC.added, SYNC.dispatched, SYNC.wakeups, SYNC.spurious,
+                          SYNC.fdsCreated, SYNC.fdsReused);
+    result += std::format("  latency: avg {}us, max {}us, <1ms: {}, <4ms: {}, <16ms: {}, >=16ms: {}\n", SYNC.dispatched ? SYNC.totalLatencyUs / SYNC.dispatched : 0,
+                          SYNC.maxLatencyUs, SYNC.latencyBuckets[0], SYNC.latencyBuckets[1], SYNC.latencyBuckets[2], SYNC.latencyBuckets[3]);
+
     if (g_pHyprCtl && g_pHyprCtl->m_sCurrentRequestParams.sysInfoConfig) {
         result += "\n======Config-Start======\n";
         result += g_pConfigManager->getConfigString();
@@ -1017,6 +1048,84 @@ std::string systemInfoRequest(eHyprCtlOutputFormat format, std::string request)
     return result;
 }
 
+std::string scanoutRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto  FEEDBACKS = PROTO::linuxDma ? PROTO::linuxDma->surfaceFeedbackStates() : std::vector<CLinuxDMABufV1Protocol::SSurfaceFeedbackState>{};
+
+    const auto  HITRATE = [](PHLMONITOR m) { return m->scanoutStats.candidateFrames == 0 ? 0.0 : (double)m->scanoutStats.scanoutFrames / m->scanoutStats.candidateFrames; };
+
+    std::string result;
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        writer.beginObject();
+
+        writer.beginArray("monitors");
+        for (auto const& m : g_pCompositor->m_vMonitors) {
+            writer.beginObject();
+            writer.field("name", m->szName);
+            writer.fieldHex("solitary", (uintptr_t)m->solitaryClient.get(), false);
+            writer.fieldHex("directScanoutTo", (uintptr_t)m->lastScanout.get(), false);
+            writer.fieldHex("feedbackSurface", (uintptr_t)m->scanoutFeedbackSurface.get(), false);
+            writer.field("candidateFrames", m->scanoutStats.candidateFrames);
+            writer.field("scanoutFrames", m->scanoutStats.scanoutFrames);
+            writer.field("hitRate", HITRATE(m), 3);
+            writer.endObject();
+        }
+        writer.endArray();
+
+        writer.beginArray("surfaces");
+        for (auto const& f : FEEDBACKS) {
+            const auto HLSURFACE = CWLSurface::fromResource(f.surface.lock());
+            const auto PWINDOW   = HLSURFACE ? HLSURFACE->getWindow() : nullptr;
+
+            writer.beginObject();
+            writer.fieldHex("surface", (uintptr_t)f.surface.get(), false);
+            writer.fieldHex("window", (uintptr_t)PWINDOW.get(), false);
+            writer.field("tranche", f.scanoutMonitor ? "scanout" : "renderer");
+            writer.field("monitor", f.scanoutMonitor ? f.scanoutMonitor->szName : "");
+            writer.endObject();
+        }
+        writer.endArray();
+
+        writer.endObject();
+        return result;
+    }
+
+    for (auto const& m : g_pCompositor->m_vMonitors) {
+        std::format_to(std::back_inserter(result), "Monitor {}:\n\tsolitary: {:x}\n\tdirectScanoutTo: {:x}\n\tfeedbackSurface: {:x}\n\tframes: {} scanned out of {} ({:.1f}%)\n\n",
+                       m->szName, (uintptr_t)m->solitaryClient.get(), (uintptr_t)m->lastScanout.get(), (uintptr_t)m->scanoutFeedbackSurface.get(), m->scanoutStats.scanoutFrames,
+                       m->scanoutStats.candidateFrames, HITRATE(m) * 100.0);
+    }
+
+    for (auto const& f : FEEDBACKS) {
+        const auto HLSURFACE = CWLSurface::fromResource(f.surface.lock());
+        const auto PWINDOW   = HLSURFACE ? HLSURFACE->getWindow() : nullptr;
+
+        std::format_to(std::back_inserter(result), "Surface {:x} (window {:x}): {} tranche{}\n", (uintptr_t)f.surface.get(), (uintptr_t)PWINDOW.get(),
+                       f.scanoutMonitor ? "scanout" : "renderer", f.scanoutMonitor ? " for " + f.scanoutMonitor->szName : "");
+    }
+
+    return result;
+}
+
+std::string renderstatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList vars(request, 0, ' ');
+
+    if (vars[1] == "reset") {
+        g_pRenderStats->reset();
+        return "ok";
+    }
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        std::string    result;
+        CHyprCtlWriter writer(result, &g_pHyprCtl->m_sCurrentRequestParams.fields);
+        g_pRenderStats->write(writer);
+        return result;
+    }
+
+    return g_pRenderStats->plain();
+}
+
 std::string dispatchRequest(eHyprCtlOutputFormat format, std::string in) {
     // get rid of the dispatch keyword
     in = in.substr(in.find_first_of(' ') + 1);
@@ -1173,7 +1282,10 @@ std::string dispatchBatch(eHyprCtlOutputFormat format, std::string request) {
     const std::string DELIMITER = "\n\n\n";
 
     while (curitem != "" || request != "") {
-        reply += g_pHyprCtl->getReply(curitem) + DELIMITER;
+        auto single = g_pHyprCtl->getReply(curitem);
+        reply += single;
+        reply += DELIMITER;
+        g_pHyprCtl->recycleReplyBuffer(std::move(single));
 
         nextItem();
     }
@@ -1645,6 +1757,7 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"binds", true, bindsRequest});
     registerCommand(SHyprCtlCommand{"globalshortcuts", true, globalShortcutsRequest});
     registerCommand(SHyprCtlCommand{"systeminfo", true, systemInfoRequest});
+    registerCommand(SHyprCtlCommand{"scanout", true, scanoutRequest});
     registerCommand(SHyprCtlCommand{"animations", true, animationsRequest});
     registerCommand(SHyprCtlCommand{"rollinglog", true, rollinglogRequest});
     registerCommand(SHyprCtlCommand{"layouts", true, layoutsRequest});
@@ -1657,6 +1770,7 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"reload", false, reloadRequest});
     registerCommand(SHyprCtlCommand{"plugin", false, dispatchPlugin});
     registerCommand(SHyprCtlCommand{"notify", false, dispatchNotify});
+    registerCommand(SHyprCtlCommand{"renderstats", false, renderstatsRequest});
     registerCommand(SHyprCtlCommand{"dismissnotify", false, dispatchDismissNotify});
     registerCommand(SHyprCtlCommand{"setprop", false, dispatchSetProp});
     registerCommand(SHyprCtlCommand{"seterror", false, dispatchSeterror});
@@ -1673,6 +1787,11 @@ CHyprCtl::CHyprCtl() {
 }
 
 CHyprCtl::~CHyprCtl() {
+    for (auto const& session : m_vSessions) {
+        wl_event_source_remove(session.eventSource);
+        close(session.fd);
+    }
+
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
     if (m_iSocketFD >= 0)
@@ -1725,6 +1844,17 @@ std::string CHyprCtl::getReply(std::string request) {
             request = request.substr(sepIndex + 1); // remove flags and separator so we can compare the rest of the string
     }
 
+    // a trailing "fields:a,b,c" selects which keys json dumps emit
+    if (const auto FIELDSPOS = request.rfind(" fields:"); FIELDSPOS != std::string::npos && !request.starts_with("[[BATCH]]")) {
+        const auto FIRSTWORD = request.substr(0, request.find(' '));
+        const bool IS_DUMP   = FIRSTWORD == "monitors" || std::ranges::any_of(m_vCommands, [&](const auto& cmd) { return cmd->exact && cmd->name == FIRSTWORD; });
+
+        if (IS_DUMP) {
+            m_sCurrentRequestParams.fields = parseHyprCtlFieldSelection(std::string_view{request}.substr(FIELDSPOS + 8));
+            request                        = request.substr(0, FIELDSPOS);
+        }
+    }
+
     std::string result = "";
 
     // parse exact cmds first, then non-exact.
@@ -1787,6 +1917,12 @@ std::string CHyprCtl::getReply(std::string request) {
     return result;
 }
 
+void CHyprCtl::recycleReplyBuffer(std::string&& reply) {
+    // list requests move m_replyBuffer out, so take back whichever allocation is bigger
+    if (reply.capacity() > m_replyBuffer.capacity())
+        m_replyBuffer = std::move(reply);
+}
+
 std::string CHyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
@@ -1804,26 +1940,42 @@ bool successWrite(int fd, const std::string& data, bool needLog = true) {
     return false;
 }
 
-void runWritingDebugLogThread(const int conn) {
-    using namespace std::chrono_literals;
+void runWritingDebugLogThread(const int conn, const int id) {
     Debug::log(LOG, "In followlog thread, got connection, start writing: {}", conn);
     //will be finished, when reading side close connection
-    std::thread([conn]() {
-        while (Debug::SRollingLogFollow::get().isRunning()) {
-            if (Debug::SRollingLogFollow::get().isEmpty(conn)) {
-                std::this_thread::sleep_for(1000ms);
-                continue;
-            }
+    std::thread([conn, id]() {
+        pollfd pollfds[] = {
+            {
+                .fd     = Debug::SRollingLogFollow::get().eventFDFor(id),
+                .events = POLLIN,
+            },
+            {
+                .fd     = conn,
+                .events = POLLIN,
+            },
+        };
+
+        if (successWrite(conn, std::format("[LOG] Following log to socket: {} started\n", conn))) {
+            while (true) {
+                if (poll(pollfds, 2, -1) < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    break;
+                }
 
-            auto line = Debug::SRollingLogFollow::get().getLog(conn);
-            if (!successWrite(conn, line))
-                // We cannot write, when connection is closed. So thread will successfully exit by itself
-                break;
+                // hyprctl never sends anything after the request, so this means the reading side went away
+                if (pollfds[1].revents)
+                    break;
 
-            std::this_thread::sleep_for(100ms);
+                // everything logged since the last wakeup goes out in one write
+                const auto LINES = Debug::SRollingLogFollow::get().getLog(id);
+                if (!LINES.empty() && !successWrite(conn, LINES, false))
+                    break;
+            }
         }
+
         close(conn);
-        Debug::SRollingLogFollow::get().stopFor(conn);
+        Debug::SRollingLogFollow::get().stopFor(id);
     }).detach();
 }
 
@@ -1831,6 +1983,173 @@ bool isFollowUpRollingLogRequest(const std::string& request) {
     return request.contains("rollinglog") && request.contains("f");
 }
 
+/*
+    Persistent sessions:
+    a client that sends HYPRCTL_SESSION_HANDSHAKE as its first bytes keeps the connection open.
+    Every following request is a frame of [u32 payload length][u32 request id][payload], in host byte order,
+    and every reply is sent back with the same header and the id of its request, in request order.
+    Requests may be pipelined, i.e. sent without waiting for the previous reply.
+*/
+constexpr std::string_view HYPRCTL_SESSION_HANDSHAKE    = "[[SESSION]]";
+constexpr size_t           HYPRCTL_SESSION_HEADER_SIZE  = sizeof(uint32_t) * 2;
+constexpr size_t           HYPRCTL_SESSION_MAX_REQUEST  = 1024 * 1024;          // 1MB
+constexpr size_t           HYPRCTL_SESSION_MAX_PENDING  = 16 * 1024 * 1024;     // unread replies before we drop the client
+constexpr size_t           HYPRCTL_SESSION_MAX_SESSIONS = 64;
+
+void CHyprCtl::startSession(int fd, std::string pending) {
+    if (m_vSessions.size() >= HYPRCTL_SESSION_MAX_SESSIONS) {
+        Debug::log(ERR, "hyprctl: refusing session on fd {}, too many open sessions", fd);
+        close(fd);
+        return;
+    }
+
+    if (const auto FLAGS = fcntl(fd, F_GETFL, 0); FLAGS < 0 || fcntl(fd, F_SETFL, FLAGS | O_NONBLOCK) < 0) {
+        Debug::log(ERR, "hyprctl: couldn't make session fd {} non-blocking", fd);
+        close(fd);
+        return;
+    }
+
+    Debug::log(LOG, "hyprctl: started a persistent session on fd {}", fd);
+
+    auto& session       = m_vSessions.emplace_back(SSession{.fd = fd, .inBuffer = std::move(pending)});
+    session.eventSource = wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, fd, WL_EVENT_READABLE, onSessionEvent, nullptr);
+
+    if (!processSessionFrames(session) || !flushSession(session))
+        removeSession(fd);
+}
+
+int CHyprCtl::onSessionEvent(int fd, uint32_t mask, void* data) {
+    return g_pHyprCtl->onSessionEvent(fd, mask);
+}
+
+int CHyprCtl::onSessionEvent(int fd, uint32_t mask) {
+    const auto SESSIONIT = std::ranges::find_if(m_vSessions, [fd](const auto& s) { return s.fd == fd; });
+
+    if (SESSIONIT == m_vSessions.end())
+        return 0;
+
+    bool closed = mask & (WL_EVENT_ERROR | WL_EVENT_HANGUP);
+
+    if (mask & WL_EVENT_READABLE) {
+        std::array<char, 8192> readBuffer;
+
+        while (true) {
+            const auto LEN = read(fd, readBuffer.data(), readBuffer.size());
+
+            if (LEN == 0) {
+                closed = true;
+                break;
+            }
+
+            if (LEN < 0) {
+                if (errno != EAGAIN && errno != EINTR)
+                    closed = true;
+                break;
+            }
+
+            SESSIONIT->inBuffer.append(readBuffer.data(), LEN);
+
+            if ((size_t)LEN < readBuffer.size())
+                break;
+        }
+
+        if (!processSessionFrames(*SESSIONIT))
+            closed = true;
+    }
+
+    // try to hand out what we have even if the client hung up, it might've only shut down its write side
+    if (!flushSession(*SESSIONIT) || closed) {
+        Debug::log(LOG, "hyprctl: session on fd {} closed", fd);
+        removeSession(fd);
+    }
+
+    return 0;
+}
+
+bool CHyprCtl::processSessionFrames(SSession& session) {
+    size_t offset = 0;
+
+    while (session.inBuffer.size() - offset >= HYPRCTL_SESSION_HEADER_SIZE) {
+        uint32_t size = 0, id = 0;
+        memcpy(&size, session.inBuffer.data() + offset, sizeof(uint32_t));
+        memcpy(&id, session.inBuffer.data() + offset + sizeof(uint32_t), sizeof(uint32_t));
+
+        if (size > HYPRCTL_SESSION_MAX_REQUEST) {
+            Debug::log(ERR, "hyprctl: session on fd {} sent an oversized request ({} bytes)", session.fd, size);
+            return false;
+        }
+
+        if (session.inBuffer.size() - offset - HYPRCTL_SESSION_HEADER_SIZE < size)
+            break; // incomplete frame, wait for more data
+
+        const std::string REQUEST = session.inBuffer.substr(offset + HYPRCTL_SESSION_HEADER_SIZE, size);
+        offset += HYPRCTL_SESSION_HEADER_SIZE + size;
+
+        std::string reply;
+        try {
+            reply = getReply(REQUEST);
+        } catch (std::exception& e) {
+            Debug::log(ERR, "Error in request: {}", e.what());
+            reply = "Err: " + std::string(e.what());
+        }
+
+        const uint32_t REPLYSIZE = reply.size();
+        session.outBuffer.append((const char*)&REPLYSIZE, sizeof(uint32_t));
+        session.outBuffer.append((const char*)&id, sizeof(uint32_t));
+        session.outBuffer += reply;
+        recycleReplyBuffer(std::move(reply));
+
+        if (session.outBuffer.size() > HYPRCTL_SESSION_MAX_PENDING) {
+            Debug::log(ERR, "hyprctl: session on fd {} isn't reading its replies, dropping", session.fd);
+            return false;
+        }
+    }
+
+    session.inBuffer.erase(0, offset);
+
+    if (g_pConfigManager->m_bWantsMonitorReload)
+        g_pConfigManager->ensureMonitorStatus();
+
+    return true;
+}
+
+bool CHyprCtl::flushSession(SSession& session) {
+    size_t written = 0;
+
+    while (written < session.outBuffer.size()) {
+        const auto LEN = write(session.fd, session.outBuffer.data() + written, session.outBuffer.size() - written);
+
+        if (LEN < 0) {
+            if (errno == EAGAIN || errno == EINTR)
+                break;
+
+            return false;
+        }
+
+        written += LEN;
+    }
+
+    session.outBuffer.erase(0, written);
+
+    // poll for write only while we have something queued
+    wl_event_source_fd_update(session.eventSource, WL_EVENT_READABLE | (session.outBuffer.empty() ? 0 : WL_EVENT_WRITABLE));
+
+    return true;
+}
+
+void CHyprCtl::removeSession(int fd) {
+    const auto SESSIONIT = std::ranges::find_if(m_vSessions, [fd](const auto& s) { return s.fd == fd; });
+
+    if (SESSIONIT == m_vSessions.end())
+        return;
+
+    if (SESSIONIT->eventSource)
+        wl_event_source_remove(SESSIONIT->eventSource);
+    close(fd);
+
+    m_vSessions.erase(SESSIONIT);
+}
+
 int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
         return 0;
@@ -1863,12 +2182,17 @@ int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
         auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
         if (messageSize < 1)
             break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
+        request.append(readBuffer.data(), messageSize);
         if (messageSize < 1023)
             break;
     }
 
+    if (request.starts_with(HYPRCTL_SESSION_HANDSHAKE)) {
+        // anything after the handshake is already the first frame(s)
+        g_pHyprCtl->startSession(ACCEPTEDCONNECTION, request.substr(HYPRCTL_SESSION_HANDSHAKE.size()));
+        return 0;
+    }
+
     std::string reply = "";
 
     try {
@@ -1879,12 +2203,17 @@ int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
     }
 
     successWrite(ACCEPTEDCONNECTION, reply);
+    g_pHyprCtl->recycleReplyBuffer(std::move(reply));
 
     if (isFollowUpRollingLogRequest(request)) {
         Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
-        Debug::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION);
-        runWritingDebugLogThread(ACCEPTEDCONNECTION);
-        Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
+        if (const auto ID = Debug::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION); ID >= 0) {
+            runWritingDebugLogThread(ACCEPTEDCONNECTION, ID);
+            Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
+        } else {
+            Debug::log(ERR, "Too many rollinglog followers, refusing another one");
+            close(ACCEPTEDCONNECTION);
+        }
     } else
         close(ACCEPTEDCONNECTION);
 
@@ -22,20 +22,43 @@ class CHyprCtl {
     int                 m_iSocketFD = -1;
 
     struct {
-        bool all           = false;
-        bool sysInfoConfig = false;
+        bool                     all           = false;
+        bool                     sysInfoConfig = false;
+        std::vector<std::string> fields; // empty means all
     } m_sCurrentRequestParams;
 
+    // reused by list requests so large replies don't regrow a fresh string every time.
+    // List requests return it by move, callers hand it back through recycleReplyBuffer once the reply is sent
+    std::string        m_replyBuffer;
+    void               recycleReplyBuffer(std::string&& reply);
+
     static std::string getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format);
     static std::string getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format);
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
+    // upgrades an accepted connection to a persistent, framed session. See hyprCtlFDTick
+    void startSession(int fd, std::string pending);
+
   private:
-    void                             startHyprCtlSocket();
+    void startHyprCtlSocket();
+
+    struct SSession {
+        int              fd          = -1;
+        wl_event_source* eventSource = nullptr;
+        std::string      inBuffer;
+        std::string      outBuffer;
+    };
+
+    static int                       onSessionEvent(int fd, uint32_t mask, void* data);
+    int                              onSessionEvent(int fd, uint32_t mask);
+    bool                             processSessionFrames(SSession& session);
+    bool                             flushSession(SSession& session);
+    void                             removeSession(int fd);
 
     std::vector<SP<SHyprCtlCommand>> m_vCommands;
     wl_event_source*                 m_eventSource = nullptr;
     std::string                      m_socketPath;
+    std::vector<SSession>            m_vSessions;
 };
 
 inline std::unique_ptr<CHyprCtl> g_pHyprCtl;
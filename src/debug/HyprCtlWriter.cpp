@@ -0,0 +1,197 @@
+#include "HyprCtlWriter.hpp"
+
+#include <algorithm>
+
+CHyprCtlWriter::CHyprCtlWriter(std::string& out, const std::vector<std::string>* fields) : m_out(out), m_fields(fields) {
+    ;
+}
+
+bool CHyprCtlWriter::wants(std::string_view key) const {
+    if (!m_fields || m_fields->empty())
+        return true;
+
+    return std::ranges::find(*m_fields, key) != m_fields->end();
+}
+
+void CHyprCtlWriter::separator() {
+    if (m_nonEmpty & (1ULL << m_depth))
+        m_out += ',';
+
+    m_nonEmpty |= (1ULL << m_depth);
+
+    if (m_depth <= 0)
+        return;
+
+    m_out += '\n';
+    m_out.append(m_depth * 4, ' ');
+}
+
+bool CHyprCtlWriter::beginValue(std::string_view key) {
+    if (m_skipDepth >= 0)
+        return false;
+
+    if (m_depth == m_selectionDepth && !wants(key))
+        return false;
+
+    separator();
+
+    if (!key.empty()) {
+        m_out += '"';
+        writeEscaped(key);
+        m_out += "\": ";
+    }
+
+    return true;
+}
+
+void CHyprCtlWriter::beginObject(std::string_view key) {
+    if (m_skipDepth < 0 && !beginValue(key))
+        m_skipDepth = m_depth;
+
+    m_depth++;
+
+    if (m_skipDepth >= 0)
+        return;
+
+    m_out += '{';
+    m_nonEmpty &= ~(1ULL << m_depth);
+
+    if (m_selectionDepth < 0)
+        m_selectionDepth = m_depth;
+}
+
+void CHyprCtlWriter::endObject() {
+    m_depth--;
+
+    if (m_skipDepth >= 0) {
+        if (m_skipDepth == m_depth)
+            m_skipDepth = -1;
+        return;
+    }
+
+    if (m_nonEmpty & (1ULL << (m_depth + 1))) {
+        m_out += '\n';
+        m_out.append(m_depth * 4, ' ');
+    }
+
+    m_out += '}';
+}
+
+void CHyprCtlWriter::beginArray(std::string_view key) {
+    if (m_skipDepth < 0 && !beginValue(key))
+        m_skipDepth = m_depth;
+
+    m_depth++;
+
+    if (m_skipDepth >= 0)
+        return;
+
+    m_out += '[';
+    m_nonEmpty &= ~(1ULL << m_depth);
+}
+
+void CHyprCtlWriter::endArray() {
+    m_depth--;
+
+    if (m_skipDepth >= 0) {
+        if (m_skipDepth == m_depth)
+            m_skipDepth = -1;
+        return;
+    }
+
+    if (m_nonEmpty & (1ULL << (m_depth + 1))) {
+        m_out += '\n';
+        m_out.append(m_depth * 4, ' ');
+    }
+
+    m_out += ']';
+}
+
+void CHyprCtlWriter::field(std::string_view key, std::string_view value) {
+    if (!beginValue(key))
+        return;
+
+    m_out += '"';
+    writeEscaped(value);
+    m_out += '"';
+}
+
+void CHyprCtlWriter::field(std::string_view key, const char* value) {
+    field(key, std::string_view{value});
+}
+
+void CHyprCtlWriter::field(std::string_view key, bool value) {
+    if (!beginValue(key))
+        return;
+
+    m_out += value ? "true" : "false";
+}
+
+void CHyprCtlWriter::field(std::string_view key, double value, int precision) {
+    if (!beginValue(key))
+        return;
+
+    if (precision < 0)
+        std::format_to(std::back_inserter(m_out), "{}", value);
+    else
+        std::format_to(std::back_inserter(m_out), "{:.{}f}", value, precision);
+}
+
+void CHyprCtlWriter::fieldHex(std::string_view key, uintptr_t value, bool prefix) {
+    if (!beginValue(key))
+        return;
+
+    if (prefix)
+        std::format_to(std::back_inserter(m_out), "\"0x{:x}\"", value);
+    else
+        std::format_to(std::back_inserter(m_out), "\"{:x}\"", value);
+}
+
+void CHyprCtlWriter::fieldRaw(std::string_view key, std::string_view value) {
+    if (!beginValue(key))
+        return;
+
+    m_out += value;
+}
+
+void CHyprCtlWriter::value(std::string_view value) {
+    field({}, value);
+}
+
+void CHyprCtlWriter::writeEscaped(std::string_view str) {
+    for (auto const& c : str) {
+        switch (c) {
+            case '"': m_out += "\\\""; break;
+            case '\\': m_out += "\\\\"; break;
+            case '\b': m_out += "\\b"; break;
+            case '\f': m_out += "\\f"; break;
+            case '\n': m_out += "\\n"; break;
+            case '\r': m_out += "\\r"; break;
+            case '\t': m_out += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20)
+                    std::format_to(std::back_inserter(m_out), "\\u{:04x}", (int)c);
+                else
+                    m_out += c;
+        }
+    }
+}
+
+std::vector<std::string> parseHyprCtlFieldSelection(std::string_view list) {
+    std::vector<std::string> result;
+
+    while (!list.empty()) {
+        const auto COMMA = list.find(',');
+        const auto FIELD = list.substr(0, COMMA);
+
+        if (!FIELD.empty())
+            result.emplace_back(FIELD);
+
+        if (COMMA == std::string_view::npos)
+            break;
+
+        list.remove_prefix(COMMA + 1);
+    }
+
+    return result;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <format>
+#include <iterator>
+#include <concepts>
+#include <cstdint>
+#include "../SharedDefs.hpp"
+
+/*
+    Streaming writer for hyprctl replies.
+    Emits JSON directly into a caller-owned buffer, without building intermediate strings.
+    Commas are handled automatically, and an optional field selection can be set,
+    in which case only the selected keys of the top-level objects are emitted.
+*/
+class CHyprCtlWriter {
+  public:
+    CHyprCtlWriter(std::string& out, const std::vector<std::string>* fields = nullptr);
+
+    void beginObject(std::string_view key = {});
+    void endObject();
+    void beginArray(std::string_view key = {});
+    void endArray();
+
+    // string values are escaped in-place
+    void field(std::string_view key, std::string_view value);
+    void field(std::string_view key, const char* value);
+    void field(std::string_view key, bool value);
+    // precision < 0 uses the shortest representation
+    void field(std::string_view key, double value, int precision = -1);
+    void fieldHex(std::string_view key, uintptr_t value, bool prefix = true);
+    // pre-formatted JSON literal, e.g. "null"
+    void fieldRaw(std::string_view key, std::string_view value);
+
+    template <typename T>
+        requires std::integral<T> && (!std::same_as<T, bool>)
+    void field(std::string_view key, T value) {
+        if (!beginValue(key))
+            return;
+
+        std::format_to(std::back_inserter(m_out), "{}", value);
+    }
+
+    // array elements
+    void value(std::string_view value);
+
+    template <typename T>
+        requires std::integral<T> && (!std::same_as<T, bool>)
+    void value(T value) {
+        field({}, value);
+    }
+
+    // whether a top-level key passes the field selection
+    bool wants(std::string_view key) const;
+
+  private:
+    bool beginValue(std::string_view key);
+    void separator();
+    void writeEscaped(std::string_view str);
+
+    std::string&                    m_out;
+    const std::vector<std::string>* m_fields = nullptr;
+
+    // bit N set: container at depth N already has an element
+    uint64_t                        m_nonEmpty       = 0;
+    int                             m_depth          = 0;
+    int                             m_selectionDepth = -1;
+    int                             m_skipDepth      = -1;
+};
+
+// field selection for the current hyprctl request, parsed from a trailing "fields:a,b,c" argument
+std::vector<std::string> parseHyprCtlFieldSelection(std::string_view list);
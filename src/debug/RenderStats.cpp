@@ -0,0 +1,157 @@
+#include "RenderStats.hpp"
+#include "HyprCtlWriter.hpp"
+#include "../Compositor.hpp"
+#include "../helpers/MiscFunctions.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sys/resource.h>
+
+constexpr size_t MAX_SAMPLES = 8192;
+
+static uint64_t envNumber(const char* env) {
+    const auto VALUE = getenv(env);
+    if (!VALUE)
+        return 0;
+
+    try {
+        return std::stoull(VALUE);
+    } catch (std::exception& e) { Debug::log(ERR, "RenderStats: invalid {}: {}", env, VALUE); }
+
+    return 0;
+}
+
+CRenderStats::CRenderStats() {
+    m_sBenchmark.frames       = envNumber("HYPRLAND_BENCHMARK_FRAMES");
+    m_sBenchmark.warmupFrames = envNumber("HYPRLAND_BENCHMARK_WARMUP");
+
+    if (const auto OUTPUT = getenv("HYPRLAND_BENCHMARK_OUTPUT"); OUTPUT)
+        m_sBenchmark.output = OUTPUT;
+
+    if (m_sBenchmark.frames > 0)
+        Debug::log(LOG, "RenderStats: benchmark mode, exiting after {} frames per monitor ({} warmup frames)", m_sBenchmark.frames, m_sBenchmark.warmupFrames);
+
+    reset();
+}
+
+float CRenderStats::SMonitorStats::percentile(float p) const {
+    if (samples.empty())
+        return 0;
+
+    auto       sorted = samples;
+    const auto NTH    = std::min(sorted.size() - 1, (size_t)(p * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + NTH, sorted.end());
+
+    return sorted[NTH];
+}
+
+void CRenderStats::onFrame(PHLMONITOR pMonitor, float durationUs) {
+    if (m_sBenchmark.done)
+        return;
+
+    // first frames compile shaders and allocate framebuffers, keep them out of the numbers
+    if (m_sBenchmark.warmupSeen < m_sBenchmark.warmupFrames) {
+        if (++m_sBenchmark.warmupSeen == m_sBenchmark.warmupFrames)
+            reset();
+        return;
+    }
+
+    auto& stats = m_mMonitors[pMonitor->ID];
+    stats.name  = pMonitor->szName;
+    stats.frames++;
+    stats.totalUs += durationUs;
+    stats.maxUs = std::max(stats.maxUs, durationUs);
+
+    if (stats.samples.size() < MAX_SAMPLES)
+        stats.samples.push_back(durationUs);
+    else
+        stats.samples[stats.nextSample] = durationUs;
+
+    stats.nextSample = (stats.nextSample + 1) % MAX_SAMPLES;
+
+    if (m_sBenchmark.frames == 0)
+        return;
+
+    const bool ALLDONE = !g_pCompositor->m_vMonitors.empty() && std::ranges::all_of(g_pCompositor->m_vMonitors, [this](const auto& m) {
+        const auto IT = m_mMonitors.find(m->ID);
+        return IT != m_mMonitors.end() && IT->second.frames >= m_sBenchmark.frames;
+    });
+
+    if (ALLDONE)
+        finishBenchmark();
+}
+
+void CRenderStats::reset() {
+    m_mMonitors.clear();
+    m_sBaseline = g_pHyprOpenGL ? g_pHyprOpenGL->m_sStats : CHyprOpenGLImpl::SStats{};
+    m_tSinceReset.reset();
+}
+
+void CRenderStats::write(CHyprCtlWriter& writer) {
+    const auto& NOW = g_pHyprOpenGL->m_sStats;
+
+    rusage      usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    writer.beginObject();
+
+    writer.field("seconds", (double)m_tSinceReset.getSeconds(), 3);
+    writer.field("drawCalls", NOW.drawCalls - m_sBaseline.drawCalls);
+    writer.field("textureUploads", NOW.textureUploads - m_sBaseline.textureUploads);
+    writer.field("uploadedBytes", NOW.uploadedBytes - m_sBaseline.uploadedBytes);
+    writer.field("framebufferAllocs", NOW.framebufferAllocs - m_sBaseline.framebufferAllocs);
+    writer.field("workspaceSnapshots", NOW.workspaceSnapshots - m_sBaseline.workspaceSnapshots);
+    writer.field("maxRSSKiB", (int64_t)usage.ru_maxrss);
+
+    writer.beginArray("monitors");
+    for (auto const& [id, m] : m_mMonitors) {
+        writer.beginObject();
+        writer.field("id", id);
+        writer.field("name", m.name);
+        writer.field("frames", m.frames);
+        writer.field("avgUs", m.frames == 0 ? 0.0 : m.totalUs / m.frames, 1);
+        writer.field("maxUs", (double)m.maxUs, 1);
+        writer.field("p50Us", (double)m.percentile(0.5F), 1);
+        writer.field("p95Us", (double)m.percentile(0.95F), 1);
+        writer.field("p99Us", (double)m.percentile(0.99F), 1);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+}
+
+std::string CRenderStats::plain() {
+    const auto& NOW = g_pHyprOpenGL->m_sStats;
+
+    std::string result = std::format("Over {:.1f}s: {} draw calls, {} texture uploads ({} bytes), {} framebuffer allocations, {} workspace snapshots\n\n",
+                                     m_tSinceReset.getSeconds(), NOW.drawCalls - m_sBaseline.drawCalls, NOW.textureUploads - m_sBaseline.textureUploads,
+                                     NOW.uploadedBytes - m_sBaseline.uploadedBytes, NOW.framebufferAllocs - m_sBaseline.framebufferAllocs,
+                                     NOW.workspaceSnapshots - m_sBaseline.workspaceSnapshots);
+
+    for (auto const& [id, m] : m_mMonitors) {
+        std::format_to(std::back_inserter(result), "Monitor {} (ID {}):\n\tframes: {}\n\tavg: {:.1f}us max: {:.1f}us\n\tp50: {:.1f}us p95: {:.1f}us p99: {:.1f}us\n\n", m.name, id,
+                       m.frames, m.frames == 0 ? 0.0 : m.totalUs / m.frames, m.maxUs, m.percentile(0.5F), m.percentile(0.95F), m.percentile(0.99F));
+    }
+
+    return result;
+}
+
+void CRenderStats::finishBenchmark() {
+    m_sBenchmark.done = true;
+
+    std::string    result;
+    CHyprCtlWriter writer(result);
+    write(writer);
+
+    if (!m_sBenchmark.output.empty()) {
+        std::ofstream ofs(m_sBenchmark.output, std::ios::trunc);
+        ofs << result << "\n";
+    }
+
+    Debug::log(LOG, "RenderStats: benchmark finished: {}", result);
+
+    // don't tear everything down from inside the render path
+    g_pEventLoopManager->doLater([]() { g_pCompositor->stopCompositor(); });
+}
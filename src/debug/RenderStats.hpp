@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Timer.hpp"
+#include "../render/OpenGL.hpp"
+#include <map>
+#include <vector>
+
+class CHyprCtlWriter;
+
+/*
+    Render timing and GL counters, aggregated per monitor since the last reset.
+    Exposed through hyprctl renderstats, and used by the benchmark mode:
+    with HYPRLAND_BENCHMARK_FRAMES=N set, Hyprland writes the stats to
+    HYPRLAND_BENCHMARK_OUTPUT (or the log) once every monitor rendered N frames, and exits.
+*/
+class CRenderStats {
+  public:
+    CRenderStats();
+
+    void        onFrame(PHLMONITOR pMonitor, float durationUs);
+    void        reset();
+
+    void        write(CHyprCtlWriter& writer);
+    std::string plain();
+
+  private:
+    struct SMonitorStats {
+        std::string        name;
+        uint64_t           frames  = 0;
+        double             totalUs = 0;
+        float              maxUs   = 0;
+
+        // ring of the most recent frame times, for percentiles
+        std::vector<float> samples;
+        size_t             nextSample = 0;
+
+        float              percentile(float p) const;
+    };
+
+    void                                 finishBenchmark();
+
+    std::map<MONITORID, SMonitorStats>   m_mMonitors;
+    CHyprOpenGLImpl::SStats              m_sBaseline;
+    CTimer                               m_tSinceReset;
+
+    struct {
+        uint64_t    frames        = 0;
+        uint64_t    warmupFrames  = 0;
+        uint64_t    warmupSeen    = 0;
+        std::string output;
+        bool        done = false;
+    } m_sBenchmark;
+};
+
+inline std::unique_ptr<CRenderStats> g_pRenderStats;
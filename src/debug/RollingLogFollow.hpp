@@ -1,65 +1,167 @@
 #pragma once
 
-#include <shared_mutex>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 namespace Debug {
+    /*
+        Broadcasts log lines to hyprctl rollinglog -f followers.
+
+        Lines go into a fixed ring of slots that every follower reads with its own cursor. Logging never
+        blocks on followers: a follower that falls more than a ring behind skips the overwritten lines
+        and is told how many it missed. Lines longer than SLOT_SIZE are truncated.
+        Each follower owns an eventfd which is signalled after every line, so its thread can sleep in
+        poll() and drain everything pending in one write.
+    */
     struct SRollingLogFollow {
-        std::unordered_map<int, std::string> socketToRollingLogFollowQueue;
-        std::shared_mutex                    m;
-        bool                                 running                    = false;
-        static constexpr size_t              ROLLING_LOG_FOLLOW_TOO_BIG = 8192;
-
-        // Returns true if the queue is empty for the given socket
-        bool isEmpty(int socket) {
-            std::shared_lock<std::shared_mutex> r(m);
-            return socketToRollingLogFollowQueue[socket].empty();
-        }
+        static constexpr size_t RING_SLOTS    = 1024;
+        static constexpr size_t SLOT_SIZE     = 1024;
+        static constexpr size_t MAX_FOLLOWERS = 16;
+
+        // slot seq is 2 * (line + 1) once line is stored, odd while it is being written
+        struct SSlot {
+            std::atomic<uint64_t>       seq = 0;
+            uint32_t                    len = 0;
+            std::array<char, SLOT_SIZE> data;
+        };
+
+        struct SFollower {
+            std::atomic<bool> active = false;
+            // created once and never closed, so addLog can't hit a reused fd number
+            int      eventFD = -1;
+            int      socket  = -1;
+            uint64_t cursor  = 0;
+        };
+
+        std::array<SSlot, RING_SLOTS>        ring;
+        std::array<SFollower, MAX_FOLLOWERS> followers;
+        std::atomic<uint64_t>                head      = 0;
+        std::atomic<int>                     following = 0;
 
         std::string debugInfo() {
-            std::shared_lock<std::shared_mutex> r(m);
-            return std::format("RollingLogFollow, got {} connections", socketToRollingLogFollowQueue.size());
+            return std::format("RollingLogFollow, got {} connections, {} lines logged", following.load(), head.load());
+        }
+
+        bool isRunning() {
+            return following.load(std::memory_order_relaxed) > 0;
         }
 
-        std::string getLog(int socket) {
-            std::unique_lock<std::shared_mutex> w(m);
+        void addLog(const std::string& log) {
+            const auto LINE = head.fetch_add(1, std::memory_order_relaxed);
+            auto&      slot = ring[LINE % RING_SLOTS];
 
-            const std::string                   ret = socketToRollingLogFollowQueue[socket];
-            socketToRollingLogFollowQueue[socket]   = "";
+            slot.seq.store(LINE * 2 + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
 
-            return ret;
-        };
+            slot.len = std::min(log.size(), SLOT_SIZE);
+            std::memcpy(slot.data.data(), log.data(), slot.len);
 
-        void addLog(const std::string& log) {
-            std::unique_lock<std::shared_mutex> w(m);
-            running = true;
-            std::vector<int> to_erase;
-            for (const auto& p : socketToRollingLogFollowQueue)
-                socketToRollingLogFollowQueue[p.first] += log + "\n";
+            slot.seq.store((LINE + 1) * 2, std::memory_order_release);
+
+            for (auto& f : followers) {
+                if (!f.active.load(std::memory_order_acquire))
+                    continue;
+
+                const uint64_t ONE = 1;
+                write(f.eventFD, &ONE, sizeof(ONE));
+            }
         }
 
-        bool isRunning() {
-            std::shared_lock<std::shared_mutex> r(m);
-            return running;
+        // Registers a follower for the socket and returns its id, or -1 if none is free.
+        // Only called from the main thread.
+        int startFor(int socket) {
+            for (size_t i = 0; i < followers.size(); ++i) {
+                auto& f = followers[i];
+                if (f.active.load(std::memory_order_relaxed))
+                    continue;
+
+                if (f.eventFD < 0)
+                    f.eventFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+                if (f.eventFD < 0)
+                    return -1;
+
+                f.socket = socket;
+                f.cursor = head.load(std::memory_order_relaxed);
+                f.active.store(true, std::memory_order_release);
+                following.fetch_add(1, std::memory_order_relaxed);
+                return i;
+            }
+
+            return -1;
+        }
+
+        void stopFor(int id) {
+            auto& f = followers[id];
+            f.active.store(false, std::memory_order_release);
+            following.fetch_sub(1, std::memory_order_relaxed);
         }
 
-        void stopFor(int socket) {
-            std::unique_lock<std::shared_mutex> w(m);
-            socketToRollingLogFollowQueue.erase(socket);
-            if (socketToRollingLogFollowQueue.empty())
-                running = false;
+        int eventFDFor(int id) {
+            return followers[id].eventFD;
         }
 
-        void startFor(int socket) {
-            std::unique_lock<std::shared_mutex> w(m);
-            socketToRollingLogFollowQueue[socket] = std::format("[LOG] Following log to socket: {} started\n", socket);
-            running                               = true;
+        // Drains the follower's eventfd and returns every line logged since the last call.
+        // Only called from the follower's own thread.
+        std::string getLog(int id) {
+            auto&    f = followers[id];
+
+            uint64_t wakeups = 0;
+            read(f.eventFD, &wakeups, sizeof(wakeups));
+
+            std::string ret;
+            uint64_t    dropped = 0;
+            const auto  HEAD    = head.load(std::memory_order_acquire);
+
+            if (HEAD - f.cursor > RING_SLOTS) {
+                dropped  = HEAD - f.cursor - RING_SLOTS;
+                f.cursor = HEAD - RING_SLOTS;
+            }
+
+            while (f.cursor < HEAD) {
+                auto&      slot = ring[f.cursor % RING_SLOTS];
+                const auto SEQ  = slot.seq.load(std::memory_order_acquire);
+
+                // still being written, the writer signals us again once it's done
+                if (SEQ < (f.cursor + 1) * 2)
+                    break;
+
+                if (SEQ == (f.cursor + 1) * 2) {
+                    const auto LEN = std::min<size_t>(slot.len, SLOT_SIZE);
+                    const auto OLD = ret.size();
+                    ret.append(slot.data.data(), LEN);
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.seq.load(std::memory_order_relaxed) == SEQ) {
+                        ret += "\n";
+                        f.cursor++;
+                        continue;
+                    }
+
+                    ret.resize(OLD);
+                }
+
+                // overwritten by a newer line while we were behind
+                dropped++;
+                f.cursor++;
+            }
+
+            if (dropped > 0)
+                ret += std::format("[LOG] Follower on socket {} is too slow, dropped {} lines\n", f.socket, dropped);
+
+            return ret;
         }
 
         static SRollingLogFollow& get() {
-            static SRollingLogFollow    instance;
-            static std::mutex           gm;
-            std::lock_guard<std::mutex> lock(gm);
+            static SRollingLogFollow instance;
             return instance;
         };
     };
@@ -409,7 +409,7 @@ void CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace) {
     m_fMovingToWorkspaceAlpha = 0.F;
     m_fMovingToWorkspaceAlpha.setCallbackOnEnd([this](void* thisptr) { m_iMonitorMovedFrom = -1; });
 
-    m_pWorkspace = pWorkspace;
+    setWorkspace(pWorkspace);
 
     setAnimationsToMove();
 
@@ -534,7 +534,7 @@ void CWindow::onUnmap() {
     g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
-    m_pWorkspace.reset();
+    setWorkspace(nullptr);
 
     if (m_bIsX11)
         return;
@@ -796,6 +796,8 @@ void CWindow::updateDynamicRules() {
         applyDynamicRule(r);
     }
 
+    g_pDecorationPositioner->invalidateWindow(m_pSelf.lock());
+
     EMIT_HOOK_EVENT("windowUpdateRules", m_pSelf.lock());
 
     g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
@@ -1171,6 +1173,8 @@ void CWindow::updateWindowData(const SWorkspaceRule& workspaceRule) {
     m_sWindowData.noBorder.matchOptional(workspaceRule.noBorder, PRIORITY_WORKSPACE_RULE);
     m_sWindowData.noRounding.matchOptional(workspaceRule.noRounding, PRIORITY_WORKSPACE_RULE);
     m_sWindowData.noShadow.matchOptional(workspaceRule.noShadow, PRIORITY_WORKSPACE_RULE);
+
+    g_pDecorationPositioner->invalidateWindow(m_pSelf.lock());
 }
 
 int CWindow::getRealBorderSize() {
@@ -1273,7 +1277,7 @@ int CWindow::surfacesCount() {
         return 1;
 
     int no = 0;
-    m_pWLSurface->resource()->breadthfirst([](SP<CWLSurfaceResource> r, const Vector2D& offset, void* d) { *((int*)d) += 1; }, &no);
+    m_pWLSurface->resource()->breadthfirst([&no](const SP<CWLSurfaceResource>& r, const Vector2D& offset) { no++; });
     return no;
 }
 
@@ -1295,6 +1299,19 @@ bool CWindow::isEffectiveInternalFSMode(const eFullscreenMode MODE) {
     return (eFullscreenMode)std::bit_floor((uint8_t)m_sFullscreenState.internal) == MODE;
 }
 
+void CWindow::setWorkspace(PHLWORKSPACE pWorkspace) {
+    if (m_pWorkspace == pWorkspace)
+        return;
+
+    if (m_pWorkspace)
+        m_pWorkspace->removeWindow(m_pSelf.lock());
+
+    m_pWorkspace = pWorkspace;
+
+    if (m_pWorkspace)
+        m_pWorkspace->addWindow(m_pSelf.lock());
+}
+
 WORKSPACEID CWindow::workspaceID() {
     return m_pWorkspace ? m_pWorkspace->m_iID : m_iLastWorkspace;
 }
@@ -1534,7 +1551,7 @@ void CWindow::onX11Configure(CBox box) {
     if (!m_pWorkspace || !m_pWorkspace->isVisible())
         return; // further things are only for visible windows
 
-    m_pWorkspace = g_pCompositor->getMonitorFromVector(m_vRealPosition.value() + m_vRealSize.value() / 2.f)->activeWorkspace;
+    setWorkspace(g_pCompositor->getMonitorFromVector(m_vRealPosition.value() + m_vRealSize.value() / 2.f)->activeWorkspace);
 
     g_pCompositor->changeWindowZOrder(m_pSelf.lock(), true);
 
@@ -17,6 +17,7 @@
 #include "Subsurface.hpp"
 #include "WLSurface.hpp"
 #include "Workspace.hpp"
+#include "WorkspaceSelector.hpp"
 
 class CXDGSurfaceResource;
 class CXWaylandSurface;
@@ -213,6 +214,9 @@ struct SWindowRule {
     std::string szFullscreenState = ""; // empty means any
     std::string szOnWorkspace     = ""; // empty means any
     std::string szWorkspace       = ""; // empty means any
+
+    // compiled szOnWorkspace
+    SP<CWorkspaceSelector> onWorkspaceSelector;
 };
 
 struct SInitialWorkspaceToken {
@@ -284,7 +288,7 @@ class CWindow {
     std::string      m_szClass          = "";
     std::string      m_szInitialTitle   = "";
     std::string      m_szInitialClass   = "";
-    PHLWORKSPACE     m_pWorkspace;
+    PHLWORKSPACE     m_pWorkspace; // set through setWorkspace()
     PHLMONITORREF    m_pMonitor;
 
     bool             m_bIsMapped = false;
@@ -422,6 +426,8 @@ class CWindow {
     void                   updateToplevel();
     void                   updateSurfaceScaleTransformDetails(bool force = false);
     void                   moveToWorkspace(PHLWORKSPACE);
+    // assigns m_pWorkspace without any of the moveToWorkspace side effects, keeping the workspace's window list in sync
+    void                   setWorkspace(PHLWORKSPACE);
     PHLWINDOW              x11TransientFor();
     void                   onUnmap();
     void                   onMap();
@@ -1,4 +1,5 @@
 #include "Workspace.hpp"
+#include "WorkspaceSelector.hpp"
 #include "../Compositor.hpp"
 #include "../config/ConfigValue.hpp"
 
@@ -16,6 +17,31 @@ CWorkspace::CWorkspace(WORKSPACEID id, PHLMONITOR monitor, std::string name, boo
     ;
 }
 
+void CWorkspace::addWindow(PHLWINDOW pWindow) {
+    std::erase_if(m_vWindows, [](const auto& w) { return w.expired(); });
+
+    if (std::ranges::none_of(m_vWindows, [&pWindow](const auto& w) { return w.get() == pWindow.get(); }))
+        m_vWindows.emplace_back(pWindow);
+}
+
+void CWorkspace::removeWindow(PHLWINDOW pWindow) {
+    std::erase_if(m_vWindows, [&pWindow](const auto& w) { return w.expired() || w.get() == pWindow.get(); });
+}
+
+template <typename F>
+void CWorkspace::forEachWindow(F&& fn) {
+    // by index: fn may end up reassigning windows, which is fine as long as we don't hold iterators
+    for (size_t i = 0; i < m_vWindows.size(); ++i) {
+        const auto PWINDOW = m_vWindows[i].lock();
+
+        // the list may be stale if m_pWorkspace was written directly
+        if (!PWINDOW || PWINDOW->m_pWorkspace.get() != this)
+            continue;
+
+        fn(PWINDOW);
+    }
+}
+
 void CWorkspace::init(PHLWORKSPACE self) {
     m_pSelf = self;
 
@@ -91,12 +117,12 @@ void CWorkspace::startAnim(bool in, bool left, bool instant) {
 
     // set floating windows offset callbacks
     m_vRenderOffset.setUpdateCallback([&](void*) {
-        for (auto const& w : g_pCompositor->m_vWindows) {
-            if (!validMapped(w) || w->workspaceID() != m_iID)
-                continue;
+        forEachWindow([](const PHLWINDOW& w) {
+            if (!validMapped(w))
+                return;
 
             w->onWorkspaceAnimUpdate();
-        };
+        });
     });
 
     if (ANIMSTYLE.starts_with("slidefade")) {
@@ -238,274 +264,8 @@ std::string CWorkspace::getConfigName() {
     return "name:" + m_szName;
 }
 
-bool CWorkspace::matchesStaticSelector(const std::string& selector_) {
-    auto selector = trim(selector_);
-
-    if (selector.empty())
-        return true;
-
-    if (isNumber(selector)) {
-        const auto& [wsid, wsname] = getWorkspaceIDNameFromString(selector);
-
-        if (wsid == WORKSPACE_INVALID)
-            return false;
-
-        return wsid == m_iID;
-
-    } else if (selector.starts_with("name:")) {
-        return m_szName == selector.substr(5);
-    } else if (selector.starts_with("special")) {
-        return m_szName == selector;
-    } else {
-        // parse selector
-
-        for (size_t i = 0; i < selector.length(); ++i) {
-            const char& cur = selector[i];
-            if (std::isspace(cur))
-                continue;
-
-            // Allowed selectors:
-            // r - range: r[1-5]
-            // s - special: s[true]
-            // n - named: n[true] or n[s:string] or n[e:string]
-            // m - monitor: m[monitor_selector]
-            // w - windowCount: w[1-4] or w[1], optional flag t or f for tiled or floating and
-            //                  flag g to count groups instead of windows, e.g. w[t1-2], w[fg4]
-            //                  flag v will count only visible windows
-            // f - fullscreen state : f[-1], f[0], f[1], or f[2] for different fullscreen states
-            //                        -1: no fullscreen, 0: fullscreen, 1: maximized, 2: fullscreen without sending fs state to window
-
-            const auto  CLOSING_BRACKET = selector.find_first_of(']', i);
-            std::string prop            = selector.substr(i, CLOSING_BRACKET == std::string::npos ? std::string::npos : CLOSING_BRACKET + 1 - i);
-            i                           = std::min(CLOSING_BRACKET, std::string::npos - 1);
-
-            if (cur == 'r') {
-                WORKSPACEID from = 0, to = 0;
-                if (!prop.starts_with("r[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop = prop.substr(2, prop.length() - 3);
-
-                if (!prop.contains("-")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                const auto DASHPOS = prop.find('-');
-                const auto LHS = prop.substr(0, DASHPOS), RHS = prop.substr(DASHPOS + 1);
-
-                if (!isNumber(LHS) || !isNumber(RHS)) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                try {
-                    from = std::stoll(LHS);
-                    to   = std::stoll(RHS);
-                } catch (std::exception& e) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                if (to < from || to < 1 || from < 1) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                if (std::clamp(m_iID, from, to) != m_iID)
-                    return false;
-                continue;
-            }
-
-            if (cur == 's') {
-                if (!prop.starts_with("s[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop = prop.substr(2, prop.length() - 3);
-
-                const auto SHOULDBESPECIAL = configStringToInt(prop);
-
-                if (SHOULDBESPECIAL && (bool)*SHOULDBESPECIAL != m_bIsSpecialWorkspace)
-                    return false;
-                continue;
-            }
-
-            if (cur == 'm') {
-                if (!prop.starts_with("m[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop = prop.substr(2, prop.length() - 3);
-
-                const auto PMONITOR = g_pCompositor->getMonitorFromString(prop);
-
-                if (!(PMONITOR ? PMONITOR == m_pMonitor : false))
-                    return false;
-                continue;
-            }
-
-            if (cur == 'n') {
-                if (!prop.starts_with("n[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop = prop.substr(2, prop.length() - 3);
-
-                if (prop.starts_with("s:") && !m_szName.starts_with(prop.substr(2)))
-                    return false;
-                if (prop.starts_with("e:") && !m_szName.ends_with(prop.substr(2)))
-                    return false;
-
-                const auto WANTSNAMED = configStringToInt(prop);
-
-                if (WANTSNAMED && *WANTSNAMED != (m_iID <= -1337))
-                    return false;
-                continue;
-            }
-
-            if (cur == 'w') {
-                WORKSPACEID from = 0, to = 0;
-                if (!prop.starts_with("w[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop = prop.substr(2, prop.length() - 3);
-
-                int  wantsOnlyTiled    = -1;
-                bool wantsCountGroup   = false;
-                bool wantsCountVisible = false;
-
-                int  flagCount = 0;
-                for (auto const& flag : prop) {
-                    if (flag == 't' && wantsOnlyTiled == -1) {
-                        wantsOnlyTiled = 1;
-                        flagCount++;
-                    } else if (flag == 'f' && wantsOnlyTiled == -1) {
-                        wantsOnlyTiled = 0;
-                        flagCount++;
-                    } else if (flag == 'g' && !wantsCountGroup) {
-                        wantsCountGroup = true;
-                        flagCount++;
-                    } else if (flag == 'v' && !wantsCountVisible) {
-                        wantsCountVisible = true;
-                        flagCount++;
-                    } else {
-                        break;
-                    }
-                }
-                prop = prop.substr(flagCount);
-
-                if (!prop.contains("-")) {
-                    // try single
-
-                    if (!isNumber(prop)) {
-                        Debug::log(LOG, "Invalid selector {}", selector);
-                        return false;
-                    }
-
-                    try {
-                        from = std::stoll(prop);
-                    } catch (std::exception& e) {
-                        Debug::log(LOG, "Invalid selector {}", selector);
-                        return false;
-                    }
-
-                    int count;
-                    if (wantsCountGroup)
-                        count = getGroups(wantsOnlyTiled == -1 ? std::nullopt : std::optional<bool>((bool)wantsOnlyTiled),
-                                          wantsCountVisible ? std::optional<bool>(wantsCountVisible) : std::nullopt);
-                    else
-                        count = getWindows(wantsOnlyTiled == -1 ? std::nullopt : std::optional<bool>((bool)wantsOnlyTiled),
-                                           wantsCountVisible ? std::optional<bool>(wantsCountVisible) : std::nullopt);
-
-                    if (count != from)
-                        return false;
-                    continue;
-                }
-
-                const auto DASHPOS = prop.find('-');
-                const auto LHS = prop.substr(0, DASHPOS), RHS = prop.substr(DASHPOS + 1);
-
-                if (!isNumber(LHS) || !isNumber(RHS)) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                try {
-                    from = std::stoll(LHS);
-                    to   = std::stoll(RHS);
-                } catch (std::exception& e) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                if (to < from || to < 1 || from < 1) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                WORKSPACEID count;
-                if (wantsCountGroup)
-                    count = getGroups(wantsOnlyTiled == -1 ? std::nullopt : std::optional<bool>((bool)wantsOnlyTiled),
-                                      wantsCountVisible ? std::optional<bool>(wantsCountVisible) : std::nullopt);
-                else
-                    count = getWindows(wantsOnlyTiled == -1 ? std::nullopt : std::optional<bool>((bool)wantsOnlyTiled),
-                                       wantsCountVisible ? std::optional<bool>(wantsCountVisible) : std::nullopt);
-
-                if (std::clamp(count, from, to) != count)
-                    return false;
-                continue;
-            }
-
-            if (cur == 'f') {
-                if (!prop.starts_with("f[") || !prop.ends_with("]")) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                prop        = prop.substr(2, prop.length() - 3);
-                int FSSTATE = -1;
-                try {
-                    FSSTATE = std::stoi(prop);
-                } catch (std::exception& e) {
-                    Debug::log(LOG, "Invalid selector {}", selector);
-                    return false;
-                }
-
-                switch (FSSTATE) {
-                    case -1: // no fullscreen
-                        if (m_bHasFullscreenWindow)
-                            return false;
-                        break;
-                    case 0: // fullscreen full
-                        if (!m_bHasFullscreenWindow || m_efFullscreenMode != FSMODE_FULLSCREEN)
-                            return false;
-                        break;
-                    case 1: // maximized
-                        if (!m_bHasFullscreenWindow || m_efFullscreenMode != FSMODE_MAXIMIZED)
-                            return false;
-                        break;
-                    default: break;
-                }
-                continue;
-            }
-
-            Debug::log(LOG, "Invalid selector {}", selector);
-            return false;
-        }
-
-        return true;
-    }
-
-    UNREACHABLE();
-    return false;
+bool CWorkspace::matchesStaticSelector(const std::string& selector) {
+    return CWorkspaceSelector{selector}.matches(this);
 }
 
 void CWorkspace::markInert() {
@@ -524,12 +284,13 @@ MONITORID CWorkspace::monitorID() {
 }
 
 PHLWINDOW CWorkspace::getFullscreenWindow() {
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace == m_pSelf && w->isFullscreen())
-            return w;
-    }
+    PHLWINDOW fullscreen;
+    forEachWindow([&fullscreen](const PHLWINDOW& w) {
+        if (!fullscreen && w->isFullscreen())
+            fullscreen = w;
+    });
 
-    return nullptr;
+    return fullscreen;
 }
 
 bool CWorkspace::isVisible() {
@@ -546,36 +307,51 @@ bool CWorkspace::isVisibleNotCovered() {
 
 int CWorkspace::getWindows(std::optional<bool> onlyTiled, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->workspaceID() != m_iID || !w->m_bIsMapped)
-            continue;
+    forEachWindow([&](const PHLWINDOW& w) {
+        if (!w->m_bIsMapped)
+            return;
         if (onlyTiled.has_value() && w->m_bIsFloating == onlyTiled.value())
-            continue;
+            return;
         if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
-            continue;
+            return;
         no++;
-    }
+    });
 
     return no;
 }
 
 int CWorkspace::getGroups(std::optional<bool> onlyTiled, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->workspaceID() != m_iID || !w->m_bIsMapped)
-            continue;
+    forEachWindow([&](const PHLWINDOW& w) {
+        if (!w->m_bIsMapped)
+            return;
         if (!w->m_sGroupData.head)
-            continue;
+            return;
         if (onlyTiled.has_value() && w->m_bIsFloating == onlyTiled.value())
-            continue;
+            return;
         if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
-            continue;
+            return;
         no++;
-    }
+    });
     return no;
 }
 
 PHLWINDOW CWorkspace::getFirstWindow() {
+    PHLWINDOW first;
+    int       candidates = 0;
+    forEachWindow([&](const PHLWINDOW& w) {
+        if (!w->m_bIsMapped || w->isHidden())
+            return;
+
+        if (!first)
+            first = w;
+        candidates++;
+    });
+
+    if (candidates <= 1)
+        return first;
+
+    // "first" is in z-order, which only the global list knows about
     for (auto const& w : g_pCompositor->m_vWindows) {
         if (w->m_pWorkspace == m_pSelf && w->m_bIsMapped && !w->isHidden())
             return w;
@@ -600,41 +376,29 @@ PHLWINDOW CWorkspace::getTopLeftWindow() {
 }
 
 bool CWorkspace::hasUrgentWindow() {
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace == m_pSelf && w->m_bIsMapped && w->m_bIsUrgent)
-            return true;
-    }
+    bool urgent = false;
+    forEachWindow([&urgent](const PHLWINDOW& w) { urgent = urgent || (w->m_bIsMapped && w->m_bIsUrgent); });
 
-    return false;
+    return urgent;
 }
 
 void CWorkspace::updateWindowDecos() {
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace != m_pSelf)
-            continue;
-
-        w->updateWindowDecos();
-    }
+    forEachWindow([](const PHLWINDOW& w) { w->updateWindowDecos(); });
 }
 
 void CWorkspace::updateWindowData() {
     const auto WORKSPACERULE = g_pConfigManager->getWorkspaceRuleFor(m_pSelf.lock());
 
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace != m_pSelf)
-            continue;
-
-        w->updateWindowData(WORKSPACERULE);
-    }
+    forEachWindow([&WORKSPACERULE](const PHLWINDOW& w) { w->updateWindowData(WORKSPACERULE); });
 }
 
 void CWorkspace::forceReportSizesToWindows() {
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace != m_pSelf || !w->m_bIsMapped || w->isHidden())
-            continue;
+    forEachWindow([](const PHLWINDOW& w) {
+        if (!w->m_bIsMapped || w->isHidden())
+            return;
 
         g_pXWaylandManager->setWindowSize(w, w->m_vRealSize.value(), true);
-    }
+    });
 }
 
 void CWorkspace::rename(const std::string& name) {
@@ -648,12 +412,13 @@ void CWorkspace::rename(const std::string& name) {
 }
 
 void CWorkspace::updateWindows() {
-    m_bHasFullscreenWindow = std::ranges::any_of(g_pCompositor->m_vWindows, [this](const auto& w) { return w->m_bIsMapped && w->m_pWorkspace == m_pSelf && w->isFullscreen(); });
+    m_bHasFullscreenWindow = false;
+    forEachWindow([this](const PHLWINDOW& w) { m_bHasFullscreenWindow = m_bHasFullscreenWindow || (w->m_bIsMapped && w->isFullscreen()); });
 
-    for (auto const& w : g_pCompositor->m_vWindows) {
-        if (!w->m_bIsMapped || w->m_pWorkspace != m_pSelf)
-            continue;
+    forEachWindow([](const PHLWINDOW& w) {
+        if (!w->m_bIsMapped)
+            return;
 
         w->updateDynamicRules();
-    }
+    });
 }
@@ -87,12 +87,23 @@ class CWorkspace {
     void             forceReportSizesToWindows();
     void             updateWindows();
 
+    // membership bookkeeping, called by CWindow::setWorkspace
+    void addWindow(PHLWINDOW pWindow);
+    void removeWindow(PHLWINDOW pWindow);
+
   private:
     void                 init(PHLWORKSPACE self);
 
     SP<HOOK_CALLBACK_FN> m_pFocusedWindowHook;
     bool                 m_bInert = true;
     WP<CWorkspace>       m_pSelf;
+
+    // windows assigned to this workspace. May hold stale entries, go through forEachWindow
+    std::vector<PHLWINDOWREF> m_vWindows;
+
+    // calls fn for every window on this workspace, mapped or not
+    template <typename F>
+    void forEachWindow(F&& fn);
 };
 
 inline bool valid(const PHLWORKSPACE& ref) {
@@ -0,0 +1,292 @@
+#include "WorkspaceSelector.hpp"
+#include "Workspace.hpp"
+#include "../Compositor.hpp"
+
+#include <hyprutils/string/String.hpp>
+using namespace Hyprutils::String;
+
+CWorkspaceSelector::CWorkspaceSelector(const std::string& selector) : m_szSelector(selector) {
+    if (parse(trim(selector)))
+        return;
+
+    Debug::log(LOG, "Invalid selector {}", selector);
+    m_vPredicates.clear();
+    m_bInvalid = true;
+}
+
+const std::string& CWorkspaceSelector::string() const {
+    return m_szSelector;
+}
+
+bool CWorkspaceSelector::invalid() const {
+    return m_bInvalid;
+}
+
+static std::optional<std::pair<int64_t, int64_t>> parseSelectorRange(const std::string& prop) {
+    if (!prop.contains("-"))
+        return std::nullopt;
+
+    const auto DASHPOS = prop.find('-');
+    const auto LHS = prop.substr(0, DASHPOS), RHS = prop.substr(DASHPOS + 1);
+
+    if (!isNumber(LHS) || !isNumber(RHS))
+        return std::nullopt;
+
+    int64_t from = 0, to = 0;
+    try {
+        from = std::stoll(LHS);
+        to   = std::stoll(RHS);
+    } catch (std::exception& e) { return std::nullopt; }
+
+    if (to < from || to < 1 || from < 1)
+        return std::nullopt;
+
+    return std::make_pair(from, to);
+}
+
+bool CWorkspaceSelector::parse(const std::string& selector) {
+    if (selector.empty())
+        return true;
+
+    if (isNumber(selector)) {
+        // +n / -n are relative to the active workspace, resolve them when matching
+        if (selector.starts_with('+') || selector.starts_with('-')) {
+            m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_ID_RELATIVE, .str = selector});
+            return true;
+        }
+
+        try {
+            m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_ID, .from = std::max(std::stoi(selector), 1)});
+        } catch (std::exception& e) { return false; }
+
+        return true;
+    }
+
+    if (selector.starts_with("name:")) {
+        m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_NAME, .str = selector.substr(5)});
+        return true;
+    }
+
+    if (selector.starts_with("special")) {
+        m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_NAME, .str = selector});
+        return true;
+    }
+
+    for (size_t i = 0; i < selector.length(); ++i) {
+        const char& cur = selector[i];
+        if (std::isspace(cur))
+            continue;
+
+        const auto CLOSING_BRACKET = selector.find_first_of(']', i);
+        const auto PROP            = selector.substr(i, CLOSING_BRACKET == std::string::npos ? std::string::npos : CLOSING_BRACKET + 1 - i);
+        i                          = std::min(CLOSING_BRACKET, std::string::npos - 1);
+
+        if (!parseProperty(cur, PROP))
+            return false;
+    }
+
+    return true;
+}
+
+bool CWorkspaceSelector::parseProperty(char type, std::string prop) {
+    // Allowed selectors:
+    // r - range: r[1-5]
+    // s - special: s[true]
+    // n - named: n[true] or n[s:string] or n[e:string]
+    // m - monitor: m[monitor_selector]
+    // w - windowCount: w[1-4] or w[1], optional flag t or f for tiled or floating and
+    //                  flag g to count groups instead of windows, e.g. w[t1-2], w[fg4]
+    //                  flag v will count only visible windows
+    // f - fullscreen state : f[-1], f[0], f[1], or f[2] for different fullscreen states
+    //                        -1: no fullscreen, 0: fullscreen, 1: maximized, 2: fullscreen without sending fs state to window
+
+    if (!std::string_view{"rsnmwf"}.contains(type))
+        return false;
+
+    if (prop.length() < 3 || prop[0] != type || prop[1] != '[' || !prop.ends_with("]"))
+        return false;
+
+    prop = prop.substr(2, prop.length() - 3);
+
+    switch (type) {
+        case 'r': {
+            const auto RANGE = parseSelectorRange(prop);
+            if (!RANGE)
+                return false;
+
+            m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_ID_RANGE, .from = RANGE->first, .to = RANGE->second});
+            return true;
+        }
+        case 's': {
+            const auto SHOULDBESPECIAL = configStringToInt(prop);
+
+            if (SHOULDBESPECIAL)
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_SPECIAL, .from = (bool)*SHOULDBESPECIAL});
+            return true;
+        }
+        case 'm': {
+            m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_MONITOR, .str = prop});
+            return true;
+        }
+        case 'n': {
+            if (prop.starts_with("s:"))
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_NAME_PREFIX, .str = prop.substr(2)});
+            if (prop.starts_with("e:"))
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_NAME_SUFFIX, .str = prop.substr(2)});
+
+            const auto WANTSNAMED = configStringToInt(prop);
+
+            if (WANTSNAMED)
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_NAMED, .from = *WANTSNAMED});
+            return true;
+        }
+        case 'w': {
+            int  wantsOnlyTiled    = -1;
+            bool wantsCountGroup   = false;
+            bool wantsCountVisible = false;
+
+            int  flagCount = 0;
+            for (auto const& flag : prop) {
+                if (flag == 't' && wantsOnlyTiled == -1) {
+                    wantsOnlyTiled = 1;
+                    flagCount++;
+                } else if (flag == 'f' && wantsOnlyTiled == -1) {
+                    wantsOnlyTiled = 0;
+                    flagCount++;
+                } else if (flag == 'g' && !wantsCountGroup) {
+                    wantsCountGroup = true;
+                    flagCount++;
+                } else if (flag == 'v' && !wantsCountVisible) {
+                    wantsCountVisible = true;
+                    flagCount++;
+                } else {
+                    break;
+                }
+            }
+            prop = prop.substr(flagCount);
+
+            const uint8_t QUERY = (wantsOnlyTiled == -1 ? 0 : (wantsOnlyTiled ? 1 : 2)) * 4 + (wantsCountGroup ? 2 : 0) + (wantsCountVisible ? 1 : 0);
+
+            if (!prop.contains("-")) {
+                // try single
+                if (!isNumber(prop))
+                    return false;
+
+                int64_t count = 0;
+                try {
+                    count = std::stoll(prop);
+                } catch (std::exception& e) { return false; }
+
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_WINDOW_COUNT, .from = count, .to = count, .countQuery = QUERY});
+                return true;
+            }
+
+            const auto RANGE = parseSelectorRange(prop);
+            if (!RANGE)
+                return false;
+
+            m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_WINDOW_COUNT, .from = RANGE->first, .to = RANGE->second, .countQuery = QUERY});
+            return true;
+        }
+        case 'f': {
+            int FSSTATE = -1;
+            try {
+                FSSTATE = std::stoi(prop);
+            } catch (std::exception& e) { return false; }
+
+            // 2 (fullscreen without sending the state to the window) isn't tracked on the workspace, so it matches anything
+            if (FSSTATE >= -1 && FSSTATE <= 1)
+                m_vPredicates.emplace_back(SPredicate{.type = WSPREDICATE_FULLSCREEN, .from = FSSTATE});
+            return true;
+        }
+        default: break;
+    }
+
+    return false;
+}
+
+static int countWindows(CWorkspace* workspace, uint8_t query) {
+    const auto TILED       = query / 4;
+    const auto ONLYTILED   = TILED == 0 ? std::nullopt : std::optional<bool>(TILED == 1);
+    const auto ONLYVISIBLE = (query & 1) ? std::optional<bool>(true) : std::nullopt;
+
+    if (query & 2)
+        return workspace->getGroups(ONLYTILED, ONLYVISIBLE);
+
+    return workspace->getWindows(ONLYTILED, ONLYVISIBLE);
+}
+
+bool CWorkspaceSelector::matches(CWorkspace* workspace) const {
+    if (m_bInvalid)
+        return false;
+
+    for (auto const& p : m_vPredicates) {
+        switch (p.type) {
+            case WSPREDICATE_ID:
+                if (workspace->m_iID != p.from)
+                    return false;
+                break;
+            case WSPREDICATE_ID_RELATIVE: {
+                const auto& [wsid, wsname] = getWorkspaceIDNameFromString(p.str);
+                if (wsid == WORKSPACE_INVALID || wsid != workspace->m_iID)
+                    return false;
+                break;
+            }
+            case WSPREDICATE_NAME:
+                if (workspace->m_szName != p.str)
+                    return false;
+                break;
+            case WSPREDICATE_NAME_PREFIX:
+                if (!workspace->m_szName.starts_with(p.str))
+                    return false;
+                break;
+            case WSPREDICATE_NAME_SUFFIX:
+                if (!workspace->m_szName.ends_with(p.str))
+                    return false;
+                break;
+            case WSPREDICATE_NAMED:
+                if (p.from != (workspace->m_iID <= -1337))
+                    return false;
+                break;
+            case WSPREDICATE_SPECIAL:
+                if ((bool)p.from != workspace->m_bIsSpecialWorkspace)
+                    return false;
+                break;
+            case WSPREDICATE_ID_RANGE:
+                if (workspace->m_iID < p.from || workspace->m_iID > p.to)
+                    return false;
+                break;
+            case WSPREDICATE_MONITOR: {
+                const auto PMONITOR = g_pCompositor->getMonitorFromString(p.str);
+                if (!PMONITOR || !(PMONITOR == workspace->m_pMonitor))
+                    return false;
+                break;
+            }
+            case WSPREDICATE_WINDOW_COUNT: {
+                const int64_t COUNT = countWindows(workspace, p.countQuery);
+                if (COUNT < p.from || COUNT > p.to)
+                    return false;
+                break;
+            }
+            case WSPREDICATE_FULLSCREEN:
+                switch (p.from) {
+                    case -1: // no fullscreen
+                        if (workspace->m_bHasFullscreenWindow)
+                            return false;
+                        break;
+                    case 0: // fullscreen full
+                        if (!workspace->m_bHasFullscreenWindow || workspace->m_efFullscreenMode != FSMODE_FULLSCREEN)
+                            return false;
+                        break;
+                    case 1: // maximized
+                        if (!workspace->m_bHasFullscreenWindow || workspace->m_efFullscreenMode != FSMODE_MAXIMIZED)
+                            return false;
+                        break;
+                    default: break;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "../SharedDefs.hpp"
+
+class CWorkspace;
+
+/*
+    A workspace selector (e.g. "r[1-5] w[t1]", "name:web", "special:term"),
+    compiled once into a list of predicates which all have to hold.
+    Anything not depending on runtime state (ranges, flags, numbers) is parsed here,
+    so matching doesn't touch the selector string anymore.
+*/
+class CWorkspaceSelector {
+  public:
+    CWorkspaceSelector() = default;
+    explicit CWorkspaceSelector(const std::string& selector);
+
+    bool               matches(CWorkspace* workspace) const;
+
+    // whether the selector failed to parse. Invalid selectors never match.
+    bool               invalid() const;
+
+    const std::string& string() const;
+
+  private:
+    enum ePredicateType : uint8_t {
+        WSPREDICATE_ID = 0,
+        WSPREDICATE_ID_RELATIVE,
+        WSPREDICATE_NAME,
+        WSPREDICATE_NAME_PREFIX,
+        WSPREDICATE_NAME_SUFFIX,
+        WSPREDICATE_NAMED,
+        WSPREDICATE_SPECIAL,
+        WSPREDICATE_ID_RANGE,
+        WSPREDICATE_MONITOR,
+        WSPREDICATE_WINDOW_COUNT,
+        WSPREDICATE_FULLSCREEN,
+    };
+
+    struct SPredicate {
+        ePredicateType type;
+        int64_t        from = 0, to = 0;
+        // (tiled: 0 any, 1 tiled, 2 floating) * 4 + (groups ? 2 : 0) + (visible ? 1 : 0)
+        uint8_t        countQuery = 0;
+        std::string    str;
+    };
+
+    bool                    parse(const std::string& selector);
+    bool                    parseProperty(char type, std::string prop);
+
+    std::string             m_szSelector;
+    std::vector<SPredicate> m_vPredicates;
+    bool                    m_bInvalid = false;
+};
@@ -4,6 +4,7 @@
 #include "../managers/input/InputManager.hpp"
 #include "../managers/SeatManager.hpp"
 #include "../config/ConfigManager.hpp"
+#include "../managers/input/KeymapCache.hpp"
 #include <sys/mman.h>
 #include <aquamarine/input/Input.hpp>
 #include <cstring>
@@ -41,13 +42,10 @@ void IKeyboard::clearManuallyAllocd() {
     if (xkbKeymap)
         xkb_keymap_unref(xkbKeymap);
 
-    if (xkbKeymapFD >= 0)
-        close(xkbKeymapFD);
-
     xkbKeymap      = nullptr;
     xkbState       = nullptr;
     xkbStaticState = nullptr;
-    xkbKeymapFD    = -1;
+    compiledKeymap.reset();
 }
 
 void IKeyboard::setKeymap(const SStringRuleNames& rules) {
@@ -56,48 +54,21 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         return;
     }
 
-    currentRules            = rules;
-    xkb_rule_names XKBRULES = {
-        .rules   = rules.rules.c_str(),
-        .model   = rules.model.c_str(),
-        .layout  = rules.layout.c_str(),
-        .variant = rules.variant.c_str(),
-        .options = rules.options.c_str(),
-    };
-
-    const auto CONTEXT = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-
-    if (!CONTEXT) {
-        Debug::log(ERR, "setKeymap: CONTEXT null??");
-        return;
-    }
+    currentRules = rules;
 
     clearManuallyAllocd();
 
     Debug::log(LOG, "Attempting to create a keymap for layout {} with variant {} (rules: {}, model: {}, options: {})", rules.layout, rules.variant, rules.rules, rules.model,
                rules.options);
 
-    if (!xkbFilePath.empty()) {
-        auto path = absolutePath(xkbFilePath, g_pConfigManager->configCurrentPath);
+    compiledKeymap = g_pKeymapCache->get(rules, xkbFilePath);
 
-        if (FILE* const KEYMAPFILE = fopen(path.c_str(), "r"); !KEYMAPFILE)
-            Debug::log(ERR, "Cannot open input:kb_file= file for reading");
-        else {
-            xkbKeymap = xkb_keymap_new_from_file(CONTEXT, KEYMAPFILE, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
-            fclose(KEYMAPFILE);
-        }
-    }
-
-    if (!xkbKeymap)
-        xkbKeymap = xkb_keymap_new_from_names(CONTEXT, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
-
-    if (!xkbKeymap) {
+    if (!compiledKeymap) {
         g_pConfigManager->addParseError("Invalid keyboard layout passed. ( rules: " + rules.rules + ", model: " + rules.model + ", variant: " + rules.variant +
                                         ", options: " + rules.options + ", layout: " + rules.layout + " )");
 
         Debug::log(ERR, "Keyboard layout {} with variant {} (rules: {}, model: {}, options: {}) couldn't have been loaded.", rules.layout, rules.variant, rules.rules, rules.model,
                    rules.options);
-        memset(&XKBRULES, 0, sizeof(XKBRULES));
 
         currentRules.rules   = "";
         currentRules.model   = "";
@@ -105,9 +76,16 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         currentRules.options = "";
         currentRules.layout  = "us";
 
-        xkbKeymap = xkb_keymap_new_from_names(CONTEXT, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
+        compiledKeymap = g_pKeymapCache->get({});
     }
 
+    if (!compiledKeymap) {
+        Debug::log(ERR, "setKeymap: the default keymap failed to compile too??");
+        return;
+    }
+
+    xkbKeymap = xkb_keymap_ref(compiledKeymap->keymap);
+
     updateXKBTranslationState(xkbKeymap);
 
     const auto NUMLOCKON = g_pConfigManager->getDeviceInt(hlName, "numlock_by_default", "input:numlock_by_default");
@@ -133,9 +111,7 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
         Debug::log(LOG, "xkb: Mod index {} (name {}) got index {}", i, MODNAMES.at(i), modIndexes.at(i));
     }
 
-    updateKeymapFD();
-
-    xkb_context_unref(CONTEXT);
+    Debug::log(LOG, "Keyboard {} uses keymap fd {}", deviceName, compiledKeymap->fd);
 
     g_pSeatManager->updateActiveKeyboardData();
 }
@@ -143,31 +119,9 @@ void IKeyboard::setKeymap(const SStringRuleNames& rules) {
 void IKeyboard::updateKeymapFD() {
     Debug::log(LOG, "Updating keymap fd for keyboard {}", deviceName);
 
-    if (xkbKeymapFD >= 0)
-        close(xkbKeymapFD);
-    xkbKeymapFD = -1;
-
-    auto cKeymapStr = xkb_keymap_get_as_string(xkbKeymap, XKB_KEYMAP_FORMAT_TEXT_V1);
-    xkbKeymapString = cKeymapStr;
-    free(cKeymapStr);
-
-    int rw, ro;
-    if (!allocateSHMFilePair(xkbKeymapString.length() + 1, &rw, &ro))
-        Debug::log(ERR, "IKeyboard: failed to allocate shm pair for the keymap");
-    else {
-        auto keymapFDDest = mmap(nullptr, xkbKeymapString.length() + 1, PROT_READ | PROT_WRITE, MAP_SHARED, rw, 0);
-        close(rw);
-        if (keymapFDDest == MAP_FAILED) {
-            Debug::log(ERR, "IKeyboard: failed to mmap a shm pair for the keymap");
-            close(ro);
-        } else {
-            memcpy(keymapFDDest, xkbKeymapString.c_str(), xkbKeymapString.length());
-            munmap(keymapFDDest, xkbKeymapString.length() + 1);
-            xkbKeymapFD = ro;
-        }
-    }
+    compiledKeymap = g_pKeymapCache->fromKeymap(xkbKeymap);
 
-    Debug::log(LOG, "Updated keymap fd to {}", xkbKeymapFD);
+    Debug::log(LOG, "Updated keymap fd to {}", compiledKeymap ? compiledKeymap->fd : -1);
 }
 
 void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
@@ -197,48 +151,36 @@ void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
     const auto STATE      = xkbState;
     const auto LAYOUTSNUM = xkb_keymap_num_layouts(KEYMAP);
 
-    const auto PCONTEXT = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-
     for (uint32_t i = 0; i < LAYOUTSNUM; ++i) {
         if (xkb_state_layout_index_is_active(STATE, i, XKB_STATE_LAYOUT_EFFECTIVE) == 1) {
             Debug::log(LOG, "Updating keyboard {:x}'s translation state from an active index {}", (uintptr_t)this, i);
 
-            CVarList       keyboardLayouts(currentRules.layout, 0, ',');
-            CVarList       keyboardModels(currentRules.model, 0, ',');
-            CVarList       keyboardVariants(currentRules.variant, 0, ',');
-
-            xkb_rule_names rules = {.rules = "", .model = "", .layout = "", .variant = "", .options = ""};
-
-            std::string    layout, model, variant;
-            layout  = keyboardLayouts[i % keyboardLayouts.size()];
-            model   = keyboardModels[i % keyboardModels.size()];
-            variant = keyboardVariants[i % keyboardVariants.size()];
+            CVarList   keyboardLayouts(currentRules.layout, 0, ',');
+            CVarList   keyboardModels(currentRules.model, 0, ',');
+            CVarList   keyboardVariants(currentRules.variant, 0, ',');
 
-            rules.layout  = layout.c_str();
-            rules.model   = model.c_str();
-            rules.variant = variant.c_str();
+            const auto LAYOUT  = keyboardLayouts[i % keyboardLayouts.size()];
+            const auto MODEL   = keyboardModels[i % keyboardModels.size()];
+            const auto VARIANT = keyboardVariants[i % keyboardVariants.size()];
 
-            auto KEYMAP = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+            auto       KEYMAP = g_pKeymapCache->get({.layout = LAYOUT, .model = MODEL, .variant = VARIANT});
 
             if (!KEYMAP) {
                 Debug::log(ERR, "updateXKBTranslationState: keymap failed 1, fallback without model/variant");
-                rules.model   = "";
-                rules.variant = "";
-                KEYMAP        = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+                KEYMAP = g_pKeymapCache->get({.layout = LAYOUT});
             }
 
             if (!KEYMAP) {
                 Debug::log(ERR, "updateXKBTranslationState: keymap failed 2, fallback to us");
-                rules.layout = "us";
-                KEYMAP       = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+                KEYMAP = g_pKeymapCache->get({.layout = "us"});
             }
 
-            xkbState       = xkb_state_new(KEYMAP);
-            xkbStaticState = xkb_state_new(KEYMAP);
-            xkbSymState    = xkb_state_new(KEYMAP);
+            if (!KEYMAP)
+                return;
 
-            xkb_keymap_unref(KEYMAP);
-            xkb_context_unref(PCONTEXT);
+            xkbState       = xkb_state_new(KEYMAP->keymap);
+            xkbStaticState = xkb_state_new(KEYMAP->keymap);
+            xkbSymState    = xkb_state_new(KEYMAP->keymap);
 
             return;
         }
@@ -246,22 +188,14 @@ void IKeyboard::updateXKBTranslationState(xkb_keymap* const keymap) {
 
     Debug::log(LOG, "Updating keyboard {:x}'s translation state from an unknown index", (uintptr_t)this);
 
-    xkb_rule_names rules = {
-        .rules   = currentRules.rules.c_str(),
-        .model   = currentRules.model.c_str(),
-        .layout  = currentRules.layout.c_str(),
-        .variant = currentRules.variant.c_str(),
-        .options = currentRules.options.c_str(),
-    };
+    const auto NEWKEYMAP = g_pKeymapCache->get(currentRules);
 
-    const auto NEWKEYMAP = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
-
-    xkbState       = xkb_state_new(NEWKEYMAP);
-    xkbStaticState = xkb_state_new(NEWKEYMAP);
-    xkbSymState    = xkb_state_new(NEWKEYMAP);
+    if (!NEWKEYMAP)
+        return;
 
-    xkb_keymap_unref(NEWKEYMAP);
-    xkb_context_unref(PCONTEXT);
+    xkbState       = xkb_state_new(NEWKEYMAP->keymap);
+    xkbStaticState = xkb_state_new(NEWKEYMAP->keymap);
+    xkbSymState    = xkb_state_new(NEWKEYMAP->keymap);
 }
 
 std::string IKeyboard::getActiveLayout() {
@@ -9,6 +9,8 @@
 
 AQUAMARINE_FORWARD(IKeyboard);
 
+class CCompiledKeymap;
+
 enum eKeyboardModifiers {
     HL_MODIFIER_SHIFT = (1 << 0),
     HL_MODIFIER_CAPS  = (1 << 1),
@@ -94,9 +96,9 @@ class IKeyboard : public IHID {
     std::array<xkb_mod_index_t, 8> modIndexes = {XKB_MOD_INVALID};
     uint32_t                       leds       = 0;
 
-    std::string                    xkbFilePath     = "";
-    std::string                    xkbKeymapString = "";
-    int                            xkbKeymapFD     = -1;
+    std::string                    xkbFilePath = "";
+    // shared with every keyboard using the same rules, see CKeymapCache
+    SP<CCompiledKeymap>            compiledKeymap;
 
     SStringRuleNames               currentRules;
     int                            repeatRate        = 0;
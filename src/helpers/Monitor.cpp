@@ -16,11 +16,13 @@
 #include "../managers/PointerManager.hpp"
 #include "../managers/eventLoop/EventLoopManager.hpp"
 #include "../protocols/core/Compositor.hpp"
+#include "../protocols/LinuxDMABUF.hpp"
 #include "sync/SyncTimeline.hpp"
 #include <aquamarine/output/Output.hpp>
 #include "debug/Log.hpp"
 #include <hyprutils/string/String.hpp>
 #include <hyprutils/utils/ScopeGuard.hpp>
+#include <algorithm>
 using namespace Hyprutils::String;
 using namespace Hyprutils::Utils;
 
@@ -166,6 +168,7 @@ void CMonitor::onConnect(bool noRule) {
         g_pCompositor->m_vMonitors.push_back(*thisWrapper);
 
     m_bEnabled = true;
+    resetScanoutRejections();
 
     output->state->resetExplicitFences();
     output->state->setEnabled(true);
@@ -308,6 +311,7 @@ void CMonitor::onDisconnect(bool destroy) {
 
     m_bEnabled             = false;
     m_bRenderingInitPassed = false;
+    resetScanoutRejections();
 
     if (BACKUPMON) {
         // snap cursor
@@ -828,6 +832,10 @@ void CMonitor::setCTM(const Mat3x3& ctm_) {
     g_pCompositor->scheduleFrameForMonitor(self.lock(), Aquamarine::IOutput::scheduleFrameReason::AQ_SCHEDULE_NEEDS_FRAME);
 }
 
+void CMonitor::resetScanoutRejections() {
+    scanoutRejections.rejected.clear();
+}
+
 bool CMonitor::attemptDirectScanout() {
     if (!mirrors.empty() || isMirror() || g_pHyprRenderer->m_bDirectScanoutBlocked)
         return false; // do not DS if this monitor is being mirrored. Will break the functionality.
@@ -849,20 +857,40 @@ bool CMonitor::attemptDirectScanout() {
     if (!PSURFACE->current.buffer || !PSURFACE->current.buffer->buffer || !PSURFACE->current.texture || !PSURFACE->current.texture->m_pEglImage /* dmabuf */)
         return false;
 
-    Debug::log(TRACE, "attemptDirectScanout: surface {:x} passed, will attempt", (uintptr_t)PSURFACE.get());
-
-    // FIXME: make sure the buffer actually follows the available scanout dmabuf formats
-    // and comes from the appropriate device. This may implode on multi-gpu!!
-
     const auto params = PSURFACE->current.buffer->buffer->dmabuf();
     // scanout buffer isn't dmabuf, so no scanout
     if (!params.success)
         return false;
 
+    // FIXME: this doesn't check the buffer comes from the scanout device. This may implode on multi-gpu!!
+    if (PROTO::linuxDma && !PROTO::linuxDma->canScanout(self.lock(), params.format, params.modifier)) {
+        Debug::log(TRACE, "attemptDirectScanout: format {:x} modifier {:x} is not in the scanout tranche", params.format, params.modifier);
+        return false;
+    }
+
+    if (scanoutRejections.size != vecPixelSize || scanoutRejections.transform != transform) {
+        resetScanoutRejections();
+        scanoutRejections.size      = vecPixelSize;
+        scanoutRejections.transform = transform;
+    }
+
+    scanoutRejections.frames++;
+
+    std::erase_if(scanoutRejections.rejected, [this](const auto& r) { return r.surface.expired() || r.retryFrame <= scanoutRejections.frames; });
+
+    if (std::find_if(scanoutRejections.rejected.begin(), scanoutRejections.rejected.end(), [&](const auto& r) {
+            return r.surface.get() == PSURFACE.get() && r.format == params.format && r.modifier == params.modifier;
+        }) != scanoutRejections.rejected.end())
+        return false;
+
+    Debug::log(TRACE, "attemptDirectScanout: surface {:x} passed, will attempt", (uintptr_t)PSURFACE.get());
+
     // entering into scanout, so save monitor format
     if (lastScanout.expired())
         prevDrmFormat = drmFormat;
 
+    const auto PREVFORMAT = drmFormat;
+
     if (drmFormat != params.format) {
         output->state->setFormat(params.format);
         drmFormat = params.format;
@@ -873,7 +901,21 @@ bool CMonitor::attemptDirectScanout() {
                                                                       Aquamarine::eOutputPresentationMode::AQ_OUTPUT_PRESENTATION_VSYNC);
 
     if (!state.test()) {
-        Debug::log(TRACE, "attemptDirectScanout: failed basic test");
+        Debug::log(TRACE, "attemptDirectScanout: failed basic test, won't retry surface {:x} format {:x} modifier {:x} for {} frames", (uintptr_t)PSURFACE.get(), params.format,
+                   params.modifier, SCANOUT_RETRY_FRAMES);
+        scanoutRejections.rejected.emplace_back(SScanoutRejection{
+            .surface    = PSURFACE,
+            .format     = params.format,
+            .modifier   = params.modifier,
+            .retryFrame = scanoutRejections.frames + SCANOUT_RETRY_FRAMES,
+        });
+
+        // put the format back, the renderer commits on top of this state
+        if (drmFormat != PREVFORMAT) {
+            output->state->setFormat(PREVFORMAT);
+            drmFormat = PREVFORMAT;
+        }
+
         return false;
     }
 
@@ -965,6 +1007,7 @@ void CMonitor::onMonitorFrame() {
         return;
 
     g_pHyprRenderer->recheckSolitaryForMonitor(self.lock());
+    g_pHyprRenderer->updateScanoutFeedback(self.lock());
 
     tearingState.busy = false;
 
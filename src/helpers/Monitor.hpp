@@ -41,6 +41,7 @@ struct SMonitorRule {
 
 class CMonitor;
 class CSyncTimeline;
+class CWLSurfaceResource;
 
 class CMonitorState {
   public:
@@ -141,6 +142,32 @@ class CMonitor {
     // for direct scanout
     PHLWINDOWREF lastScanout;
 
+    // surface currently sent this monitor's scanout dmabuf feedback tranche
+    WP<CWLSurfaceResource> scanoutFeedbackSurface;
+
+    struct {
+        uint64_t candidateFrames = 0; // frames with a solitary client while direct scanout is enabled
+        uint64_t scanoutFrames   = 0;
+    } scanoutStats;
+
+    // surfaces whose buffers the backend refused to scan out in a test commit. Test commits aren't free,
+    // so a (surface, format, modifier) isn't retried for SCANOUT_RETRY_FRAMES frames, or until the output state changes.
+    static constexpr uint64_t SCANOUT_RETRY_FRAMES = 300;
+
+    struct SScanoutRejection {
+        WP<CWLSurfaceResource> surface;
+        uint32_t               format     = 0;
+        uint64_t               modifier   = 0;
+        uint64_t               retryFrame = 0;
+    };
+
+    struct {
+        std::vector<SScanoutRejection> rejected;
+        uint64_t                       frames = 0; // frames direct scanout was considered on
+        Vector2D                       size;
+        wl_output_transform            transform = WL_OUTPUT_TRANSFORM_NORMAL;
+    } scanoutRejections;
+
     struct {
         bool canTear         = false;
         bool nextRenderTorn  = false;
@@ -183,6 +210,7 @@ class CMonitor {
     CBox        logicalBox();
     void        scheduleDone();
     bool        attemptDirectScanout();
+    void        resetScanoutRejections();
     void        setCTM(const Mat3x3& ctm);
 
     void        debugLastPresentation(const std::string& message);
@@ -5,6 +5,37 @@
 #include <xf86drm.h>
 #include <sys/eventfd.h>
 
+struct SSyncWaiterSlot {
+    int               fd     = -1;
+    wl_event_source*  source = nullptr;
+    WP<CSyncTimeline> timeline;
+};
+
+// slots of destroyed timelines, kept around so new timelines don't need a new eventfd and event source
+static std::vector<SSyncWaiterSlot*> waiterSlotPool;
+static CSyncTimeline::SWaiterStats   waiterStatsData;
+constexpr size_t                     MAX_POOLED_WAITER_SLOTS = 16;
+
+static void                          destroyWaiterSlot(SSyncWaiterSlot* slot) {
+    if (slot->source)
+        wl_event_source_remove(slot->source);
+    if (slot->fd >= 0)
+        close(slot->fd);
+    delete slot;
+}
+
+static void releaseWaiterSlot(SSyncWaiterSlot* slot) {
+    slot->timeline.reset();
+
+    // the kernel may still signal points registered by the old timeline, a stale wakeup is harmless for the next owner
+    if (waiterSlotPool.size() >= MAX_POOLED_WAITER_SLOTS) {
+        destroyWaiterSlot(slot);
+        return;
+    }
+
+    waiterSlotPool.emplace_back(slot);
+}
+
 SP<CSyncTimeline> CSyncTimeline::create(int drmFD_) {
     auto timeline   = SP<CSyncTimeline>(new CSyncTimeline);
     timeline->drmFD = drmFD_;
@@ -32,6 +63,9 @@ SP<CSyncTimeline> CSyncTimeline::create(int drmFD_, int drmSyncobjFD) {
 }
 
 CSyncTimeline::~CSyncTimeline() {
+    if (waiterSlot)
+        releaseWaiterSlot(waiterSlot);
+
     if (handle == 0)
         return;
 
@@ -55,74 +89,132 @@ std::optional<bool> CSyncTimeline::check(uint64_t point, uint32_t flags) {
     return ret == 0;
 }
 
-static int handleWaiterFD(int fd, uint32_t mask, void* data) {
-    auto waiter = (CSyncTimeline::SWaiter*)data;
+const CSyncTimeline::SWaiterStats& CSyncTimeline::waiterStats() {
+    return waiterStatsData;
+}
+
+int CSyncTimeline::onWaiterFD(int fd, uint32_t mask, void* data) {
+    auto slot = (SSyncWaiterSlot*)data;
 
     if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
-        Debug::log(ERR, "handleWaiterFD: eventfd error");
+        Debug::log(ERR, "CSyncTimeline: waiter eventfd error");
         return 0;
     }
 
+    // read before checking the points: anything signaled after this makes the fd readable again, so no wakeup is lost
     if (mask & WL_EVENT_READABLE) {
         uint64_t value = 0;
         if (read(fd, &value, sizeof(value)) <= 0)
-            Debug::log(ERR, "handleWaiterFD: failed to read from eventfd");
+            Debug::log(ERR, "CSyncTimeline: failed to read from the waiter eventfd");
     }
 
-    wl_event_source_remove(waiter->source);
-    waiter->source = nullptr;
-
-    if (waiter->fn)
-        waiter->fn();
+    waiterStatsData.wakeups++;
 
-    if (waiter->timeline)
-        waiter->timeline->removeWaiter(waiter);
+    if (const auto TIMELINE = slot->timeline.lock(); TIMELINE)
+        TIMELINE->dispatchWaiters();
+    else
+        waiterStatsData.spurious++;
 
     return 0;
 }
 
-bool CSyncTimeline::addWaiter(const std::function<void()>& waiter, uint64_t point, uint32_t flags) {
-    auto w      = makeShared<SWaiter>();
-    w->fn       = waiter;
-    w->timeline = self;
+void CSyncTimeline::dispatchWaiters() {
+    // one eventfd serves all waiters, so check which points are actually done.
+    // Callbacks can add or remove waiters, so take the ready ones out first.
+    std::vector<SP<SWaiter>> ready;
+    std::erase_if(waiters, [this, &ready](const auto& w) {
+        // if the check fails, fire anyway: the kernel did signal, and a stuck surface is worse than an early one
+        if (!check(w->point, w->flags).value_or(true))
+            return false;
+
+        ready.emplace_back(w);
+        return true;
+    });
+
+    if (ready.empty()) {
+        waiterStatsData.spurious++;
+        return;
+    }
 
-    int eventFD = eventfd(0, EFD_CLOEXEC);
+    const auto NOW = std::chrono::steady_clock::now();
+
+    for (auto const& w : ready) {
+        const uint64_t LATENCY = std::chrono::duration_cast<std::chrono::microseconds>(NOW - w->added).count();
+
+        waiterStatsData.dispatched++;
+        waiterStatsData.totalLatencyUs += LATENCY;
+        waiterStatsData.latencyBuckets[LATENCY < 1000 ? 0 : (LATENCY < 4000 ? 1 : (LATENCY < 16000 ? 2 : 3))]++;
+        waiterStatsData.maxLatencyUs = std::max(waiterStatsData.maxLatencyUs, LATENCY);
+
+        if (w->fn)
+            w->fn();
+    }
+}
 
-    if (eventFD < 0) {
+bool CSyncTimeline::ensureWaiterSlot() {
+    if (waiterSlot)
+        return true;
+
+    if (!waiterSlotPool.empty()) {
+        waiterSlot = waiterSlotPool.back();
+        waiterSlotPool.pop_back();
+
+        waiterSlot->timeline = self;
+        waiterStatsData.fdsReused++;
+        return true;
+    }
+
+    auto slot = new SSyncWaiterSlot;
+    slot->fd  = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (slot->fd < 0) {
         Debug::log(ERR, "CSyncTimeline::addWaiter: failed to acquire an eventfd");
+        delete slot;
         return false;
     }
 
+    slot->source = wl_event_loop_add_fd(g_pEventLoopManager->m_sWayland.loop, slot->fd, WL_EVENT_READABLE, CSyncTimeline::onWaiterFD, slot);
+    if (!slot->source) {
+        Debug::log(ERR, "CSyncTimeline::addWaiter: wl_event_loop_add_fd failed");
+        destroyWaiterSlot(slot);
+        return false;
+    }
+
+    slot->timeline = self;
+    waiterSlot     = slot;
+    waiterStatsData.fdsCreated++;
+    return true;
+}
+
+bool CSyncTimeline::addWaiter(const std::function<void()>& waiter, uint64_t point, uint32_t flags) {
+    if (!ensureWaiterSlot())
+        return false;
+
     drm_syncobj_eventfd syncobjEventFD = {
         .handle = handle,
         .flags  = flags,
         .point  = point,
-        .fd     = eventFD,
+        .fd     = waiterSlot->fd,
     };
 
     if (drmIoctl(drmFD, DRM_IOCTL_SYNCOBJ_EVENTFD, &syncobjEventFD) != 0) {
         Debug::log(ERR, "CSyncTimeline::addWaiter: drmIoctl failed");
-        close(eventFD);
         return false;
     }
 
-    w->source = wl_event_loop_add_fd(g_pEventLoopManager->m_sWayland.loop, eventFD, WL_EVENT_READABLE, ::handleWaiterFD, w.get());
-    if (!w->source) {
-        Debug::log(ERR, "CSyncTimeline::addWaiter: wl_event_loop_add_fd failed");
-        close(eventFD);
-        return false;
-    }
+    auto w   = makeShared<SWaiter>();
+    w->fn    = waiter;
+    w->point = point;
+    w->flags = flags;
+    w->added = std::chrono::steady_clock::now();
 
     waiters.emplace_back(w);
+    waiterStatsData.added++;
 
     return true;
 }
 
 void CSyncTimeline::removeWaiter(SWaiter* w) {
-    if (w->source) {
-        wl_event_source_remove(w->source);
-        w->source = nullptr;
-    }
     std::erase_if(waiters, [w](const auto& e) { return e.get() == w; });
 }
 
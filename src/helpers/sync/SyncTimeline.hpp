@@ -4,6 +4,8 @@
 #include <optional>
 #include <vector>
 #include <functional>
+#include <chrono>
+#include <array>
 #include "../memory/Memory.hpp"
 
 /*
@@ -12,6 +14,7 @@
 */
 
 struct wl_event_source;
+struct SSyncWaiterSlot;
 
 class CSyncTimeline {
   public:
@@ -20,11 +23,30 @@ class CSyncTimeline {
     ~CSyncTimeline();
 
     struct SWaiter {
-        std::function<void()> fn;
-        wl_event_source*      source = nullptr;
-        WP<CSyncTimeline>     timeline;
+        std::function<void()>                 fn;
+        uint64_t                              point = 0;
+        uint32_t                              flags = 0;
+        std::chrono::steady_clock::time_point added;
     };
 
+    // global waiter counters, for diagnosing sync-related frame delays
+    struct SWaiterStats {
+        uint64_t added      = 0;
+        uint64_t dispatched = 0;
+        uint64_t wakeups    = 0;
+        uint64_t spurious   = 0; // wakeups that didn't complete any waiter
+        uint64_t fdsCreated = 0;
+        uint64_t fdsReused  = 0;
+
+        // latency from addWaiter to the callback
+        uint64_t totalLatencyUs = 0;
+        uint64_t maxLatencyUs   = 0;
+        // < 1ms, < 4ms, < 16ms, >= 16ms
+        std::array<uint64_t, 4> latencyBuckets = {};
+    };
+
+    static const SWaiterStats& waiterStats();
+
     // check if the timeline point has been signaled
     // flags: DRM_SYNCOBJ_WAIT_FLAGS_WAIT_FOR_SUBMIT or DRM_SYNCOBJ_WAIT_FLAGS_WAIT_AVAILABLE
     // std::nullopt on fail
@@ -44,5 +66,12 @@ class CSyncTimeline {
   private:
     CSyncTimeline() = default;
 
+    bool                     ensureWaiterSlot();
+    void                     dispatchWaiters();
+    static int               onWaiterFD(int fd, uint32_t mask, void* data);
+
     std::vector<SP<SWaiter>> waiters;
+
+    // one eventfd + event source shared by all waiters of this timeline, returned to a pool on destruction
+    SSyncWaiterSlot* waiterSlot = nullptr;
 };
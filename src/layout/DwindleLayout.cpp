@@ -898,7 +898,9 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_pMonitor, pWindow->m_pMonitor);
-        std::swap(pWindow2->m_pWorkspace, pWindow->m_pWorkspace);
+        const auto PWORKSPACE1 = pWindow->m_pWorkspace;
+        pWindow->setWorkspace(pWindow2->m_pWorkspace);
+        pWindow2->setWorkspace(PWORKSPACE1);
     }
 
     pWindow->setAnimationsToMove();
@@ -944,7 +944,9 @@ void CHyprMasterLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_pMonitor, pWindow->m_pMonitor);
-        std::swap(pWindow2->m_pWorkspace, pWindow->m_pWorkspace);
+        const auto PWORKSPACE1 = pWindow->m_pWorkspace;
+        pWindow->setWorkspace(pWindow2->m_pWorkspace);
+        pWindow2->setWorkspace(PWORKSPACE1);
     }
 
     // massive hack: just swap window pointers, lol
@@ -91,6 +91,11 @@ void CAnimationManager::tick() {
         bool         animationsDisabled = animGlobalDisabled;
 
         if (PWINDOW) {
+            // the window itself moves, resizes or fades, not just the workspace it slides with.
+            // Decorations, dim and active/inactive alpha don't count, decorations are drawn live around the snapshot.
+            if (av == &PWINDOW->m_vRealPosition || av == &PWINDOW->m_vRealSize || av == &PWINDOW->m_fAlpha)
+                g_pHyprRenderer->invalidateWorkspaceSnapshot(PWINDOW->m_pWorkspace);
+
             if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE) {
                 g_pHyprRenderer->damageWindow(PWINDOW);
             } else if (av->m_eDamagePolicy == AVARDAMAGE_BORDER) {
@@ -1,6 +1,7 @@
 #include "../config/ConfigValue.hpp"
 #include "../devices/IKeyboard.hpp"
 #include "../managers/SeatManager.hpp"
+#include "../managers/input/KeymapCache.hpp"
 #include "../protocols/LayerShell.hpp"
 #include "../protocols/ShortcutsInhibit.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
@@ -261,30 +262,21 @@ void CKeybindManager::updateXKBTranslationState() {
     const std::string VARIANT  = std::string{*PVARIANT} == STRVAL_EMPTY ? "" : *PVARIANT;
     const std::string OPTIONS  = std::string{*POPTIONS} == STRVAL_EMPTY ? "" : *POPTIONS;
 
-    xkb_rule_names    rules      = {.rules = RULES.c_str(), .model = MODEL.c_str(), .layout = LAYOUT.c_str(), .variant = VARIANT.c_str(), .options = OPTIONS.c_str()};
-    const auto        PCONTEXT   = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-    FILE* const       KEYMAPFILE = FILEPATH == "" ? nullptr : fopen(absolutePath(FILEPATH, g_pConfigManager->configCurrentPath).c_str(), "r");
-
-    auto              PKEYMAP = KEYMAPFILE ? xkb_keymap_new_from_file(PCONTEXT, KEYMAPFILE, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS) :
-                                             xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
-    if (KEYMAPFILE)
-        fclose(KEYMAPFILE);
+    auto              PKEYMAP = g_pKeymapCache->get({.layout = LAYOUT, .model = MODEL, .variant = VARIANT, .options = OPTIONS, .rules = RULES}, FILEPATH);
 
     if (!PKEYMAP) {
         g_pHyprError->queueCreate("[Runtime Error] Invalid keyboard layout passed. ( rules: " + RULES + ", model: " + MODEL + ", variant: " + VARIANT + ", options: " + OPTIONS +
                                       ", layout: " + LAYOUT + " )",
                                   CHyprColor(1.0, 50.0 / 255.0, 50.0 / 255.0, 1.0));
 
-        Debug::log(ERR, "[XKBTranslationState] Keyboard layout {} with variant {} (rules: {}, model: {}, options: {}) couldn't have been loaded.", rules.layout, rules.variant,
-                   rules.rules, rules.model, rules.options);
-        memset(&rules, 0, sizeof(rules));
+        Debug::log(ERR, "[XKBTranslationState] Keyboard layout {} with variant {} (rules: {}, model: {}, options: {}) couldn't have been loaded.", LAYOUT, VARIANT, RULES, MODEL,
+                   OPTIONS);
 
-        PKEYMAP = xkb_keymap_new_from_names(PCONTEXT, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+        PKEYMAP = g_pKeymapCache->get({});
     }
 
-    xkb_context_unref(PCONTEXT);
-    m_pXKBTranslationState = xkb_state_new(PKEYMAP);
-    xkb_keymap_unref(PKEYMAP);
+    if (PKEYMAP)
+        m_pXKBTranslationState = xkb_state_new(PKEYMAP->keymap);
 }
 
 bool CKeybindManager::ensureMouseBindState() {
@@ -2553,7 +2545,7 @@ SDispatchResult CKeybindManager::pinActive(std::string args) {
         return {.success = false, .error = "pin: window not found"};
     }
 
-    PWINDOW->m_pWorkspace = PMONITOR->activeWorkspace;
+    PWINDOW->setWorkspace(PMONITOR->activeWorkspace);
 
     PWINDOW->updateDynamicRules();
     g_pCompositor->updateWindowAnimatedDecorationValues(PWINDOW);
@@ -3025,6 +3017,7 @@ SDispatchResult CKeybindManager::setProp(std::string args) {
             return {.success = false, .error = "Prop not found"};
     } catch (std::exception& e) { return {.success = false, .error = std::format("Error parsing prop value: {}", std::string(e.what()))}; }
 
+    g_pDecorationPositioner->invalidateWindow(PWINDOW);
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
     if (!(PWINDOW->m_sWindowData.noFocus.valueOrDefault() == noFocus)) {
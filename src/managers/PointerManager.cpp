@@ -363,6 +363,10 @@ bool CPointerManager::setHWCursorBuffer(SP<SMonitorPointerState> state, SP<Aquam
     if (!state->monitor->output->setCursor(buf, HOTSPOT))
         return false;
 
+    // the cursor plane got enabled or disabled, which changes what the primary plane can scan out
+    if (!buf != !state->cursorFrontBuffer)
+        state->monitor->resetScanoutRejections();
+
     state->cursorFrontBuffer = buf;
 
     if (!state->monitor->shouldSkipScheduleFrameOnMouseEvent())
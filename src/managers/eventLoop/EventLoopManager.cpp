@@ -60,9 +60,31 @@ void CEventLoopManager::enterLoop() {
 }
 
 void CEventLoopManager::onTimerFire() {
-    for (auto const& t : m_sTimers.timers) {
-        if (t.strongRef() > 1 /* if it's 1, it was lost. Don't call it. */ && t->passed() && !t->cancelled())
-            t->call(t);
+    // remove timers that have gone missing
+    std::erase_if(m_sTimers.timers, [](const auto& t) {
+        if (t.strongRef() > 1)
+            return false;
+        t->registered = false;
+        return true;
+    });
+
+    // the timerfd fired, either for the earliest deadline or a stale one
+    m_sTimers.programmed.reset();
+
+    // deadlines queued by callbacks below are never before NOW, so this terminates
+    const auto NOW = std::chrono::steady_clock::now();
+
+    while (!m_sTimers.queue.empty() && m_sTimers.queue.front().expires < NOW) {
+        std::pop_heap(m_sTimers.queue.begin(), m_sTimers.queue.end(), std::greater<>{});
+        const auto DEADLINE = m_sTimers.queue.back();
+        m_sTimers.queue.pop_back();
+
+        if (!isQueued(DEADLINE))
+            continue;
+
+        const auto TIMER = DEADLINE.timer.lock();
+        if (!TIMER->cancelled())
+            TIMER->call(TIMER);
     }
 
     nudgeTimers();
@@ -70,12 +92,42 @@ void CEventLoopManager::onTimerFire() {
 
 void CEventLoopManager::addTimer(SP<CEventLoopTimer> timer) {
     m_sTimers.timers.push_back(timer);
-    nudgeTimers();
+    timer->self       = timer;
+    timer->registered = true;
+
+    if (timer->armed())
+        scheduleTimer(timer.get());
 }
 
 void CEventLoopManager::removeTimer(SP<CEventLoopTimer> timer) {
     std::erase_if(m_sTimers.timers, [timer](const auto& t) { return timer == t; });
-    nudgeTimers();
+
+    if (timer)
+        timer->registered = false;
+}
+
+void CEventLoopManager::scheduleTimer(CEventLoopTimer* timer) {
+    const auto EXPIRES = *timer->expires;
+
+    m_sTimers.queue.emplace_back(STimerDeadline{EXPIRES, timer->self, timer->generation});
+    std::push_heap(m_sTimers.queue.begin(), m_sTimers.queue.end(), std::greater<>{});
+
+    // pushing a deadline out (e.g. idle timers on input) leaves the timerfd alone, the early wakeup re-arms it
+    if (!m_sTimers.programmed.has_value() || EXPIRES < *m_sTimers.programmed)
+        armTimerFD(EXPIRES);
+
+    if (m_sTimers.queue.size() > m_sTimers.timers.size() * 4 + 64)
+        compactTimerQueue();
+}
+
+bool CEventLoopManager::isQueued(const STimerDeadline& deadline) {
+    const auto TIMER = deadline.timer.lock();
+    return TIMER && TIMER->registered && TIMER->generation == deadline.generation && TIMER->armed();
+}
+
+void CEventLoopManager::compactTimerQueue() {
+    std::erase_if(m_sTimers.queue, [this](const auto& d) { return !isQueued(d); });
+    std::make_heap(m_sTimers.queue.begin(), m_sTimers.queue.end(), std::greater<>{});
 }
 
 static void timespecAddNs(timespec* pTimespec, int64_t delta) {
@@ -92,15 +144,20 @@ static void timespecAddNs(timespec* pTimespec, int64_t delta) {
 }
 
 void CEventLoopManager::nudgeTimers() {
-    // remove timers that have gone missing
-    std::erase_if(m_sTimers.timers, [](const auto& t) { return t.strongRef() <= 1; });
+    // drop stale deadlines off the top so the timerfd is armed for a live one
+    while (!m_sTimers.queue.empty() && !isQueued(m_sTimers.queue.front())) {
+        std::pop_heap(m_sTimers.queue.begin(), m_sTimers.queue.end(), std::greater<>{});
+        m_sTimers.queue.pop_back();
+    }
+
+    armTimerFD(m_sTimers.queue.empty() ? std::nullopt : std::optional{m_sTimers.queue.front().expires});
+}
 
+void CEventLoopManager::armTimerFD(std::optional<std::chrono::steady_clock::time_point> when) {
     long nextTimerUs = 10L * 1000 * 1000; // 10s
 
-    for (auto const& t : m_sTimers.timers) {
-        if (auto const& µs = t->leftUs(); µs < nextTimerUs)
-            nextTimerUs = µs;
-    }
+    if (when.has_value())
+        nextTimerUs = std::min(nextTimerUs, (long)std::chrono::duration_cast<std::chrono::microseconds>(*when - std::chrono::steady_clock::now()).count());
 
     nextTimerUs = std::clamp(nextTimerUs + 1, 1L, std::numeric_limits<long>::max());
 
@@ -111,6 +168,8 @@ void CEventLoopManager::nudgeTimers() {
     itimerspec ts = {.it_value = now};
 
     timerfd_settime(m_sTimers.timerfd, TFD_TIMER_ABSTIME, &ts, nullptr);
+
+    m_sTimers.programmed = std::chrono::steady_clock::now() + std::chrono::microseconds(nextTimerUs);
 }
 
 void CEventLoopManager::doLater(const std::function<void()>& fn) {
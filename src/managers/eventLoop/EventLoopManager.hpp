@@ -3,6 +3,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <optional>
+#include <vector>
 #include <wayland-server.h>
 
 #include "EventLoopTimer.hpp"
@@ -24,6 +26,9 @@ class CEventLoopManager {
 
     void onTimerFire();
 
+    // queues the timer's current deadline, only touches the timerfd if it now fires earlier
+    void scheduleTimer(CEventLoopTimer* timer);
+
     // recalculates timers
     void nudgeTimers();
 
@@ -43,11 +48,29 @@ class CEventLoopManager {
         std::vector<wl_event_source*> aqEventSources;
     } m_sWayland;
 
+    struct STimerDeadline {
+        std::chrono::steady_clock::time_point expires;
+        WP<CEventLoopTimer>                   timer;
+        uint64_t                              generation = 0;
+
+        bool                                  operator>(const STimerDeadline& other) const {
+            return expires > other.expires;
+        }
+    };
+
     struct {
         std::vector<SP<CEventLoopTimer>> timers;
         int                              timerfd = -1;
+
+        // min-heap on expires. Re-armed or removed timers leave stale entries behind, skipped when popped.
+        std::vector<STimerDeadline>                          queue;
+        std::optional<std::chrono::steady_clock::time_point> programmed;
     } m_sTimers;
 
+    bool                                 isQueued(const STimerDeadline& deadline);
+    void                                 armTimerFD(std::optional<std::chrono::steady_clock::time_point> when);
+    void                                 compactTimerQueue();
+
     SIdleData                            m_sIdle;
     std::vector<SP<Aquamarine::SPollFD>> aqPollFDs;
 
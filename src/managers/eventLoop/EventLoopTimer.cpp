@@ -12,15 +12,18 @@ CEventLoopTimer::CEventLoopTimer(std::optional<std::chrono::steady_clock::durati
 }
 
 void CEventLoopTimer::updateTimeout(std::optional<std::chrono::steady_clock::duration> timeout) {
+    generation++;
+
     if (!timeout.has_value()) {
+        // the timerfd is left as is, a stale wakeup is skipped by the manager
         expires.reset();
-        g_pEventLoopManager->nudgeTimers();
         return;
     }
 
     expires = std::chrono::steady_clock::now() + *timeout;
 
-    g_pEventLoopManager->nudgeTimers();
+    if (registered)
+        g_pEventLoopManager->scheduleTimer(this);
 }
 
 bool CEventLoopTimer::passed() {
@@ -32,6 +35,7 @@ bool CEventLoopTimer::passed() {
 void CEventLoopTimer::cancel() {
     wasCancelled = true;
     expires.reset();
+    generation++;
 }
 
 bool CEventLoopTimer::cancelled() {
@@ -40,6 +44,7 @@ bool CEventLoopTimer::cancelled() {
 
 void CEventLoopTimer::call(SP<CEventLoopTimer> self) {
     expires.reset();
+    generation++;
     cb(self, data);
 }
 
@@ -29,4 +29,13 @@ class CEventLoopTimer {
     void*                                                     data = nullptr;
     std::optional<std::chrono::steady_clock::time_point>      expires;
     bool                                                      wasCancelled = false;
+
+    // set by the manager while the timer is added
+    WP<CEventLoopTimer> self;
+    bool                registered = false;
+
+    // bumped on every re-arm, invalidates the deadline queued previously
+    uint64_t generation = 0;
+
+    friend class CEventLoopManager;
 };
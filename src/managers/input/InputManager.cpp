@@ -1,4 +1,5 @@
 #include "InputManager.hpp"
+#include "KeymapCache.hpp"
 #include "../../Compositor.hpp"
 #include <aquamarine/output/Output.hpp>
 #include <cstdint>
@@ -83,7 +84,8 @@ CInputManager::~CInputManager() {
 }
 
 void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
-    static auto PNOACCEL = CConfigValue<Hyprlang::INT>("input:force_no_accel");
+    static auto PNOACCEL  = CConfigValue<Hyprlang::INT>("input:force_no_accel");
+    static auto PCOALESCE = CConfigValue<Hyprlang::INT>("input:coalesce_motion");
 
     const auto  DELTA = *PNOACCEL == 1 ? e.unaccel : e.delta;
 
@@ -96,13 +98,50 @@ void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
 
     g_pPointerManager->move(DELTA);
 
-    mouseMoveUnified(e.timeMs);
+    if (!*PCOALESCE || !sendCoalescedMotion(e.timeMs))
+        mouseMoveUnified(e.timeMs);
 
     m_tmrLastCursorMovement.reset();
 
     m_bLastInputTouch = false;
 }
 
+bool CInputManager::sendCoalescedMotion(uint32_t time) {
+    const auto FOCUS = g_pSeatManager->state.pointerFocus.lock();
+
+    // only while the focused surface is the one the last full pass mapped coords for, everything else needs the full pipeline
+    if (!FOCUS || FOCUS != m_sMotionBatch.surface.lock() || isConstrained() || g_pSessionLockManager->isSessionLocked())
+        return false;
+
+    m_sMotionBatch.sentLocal = (getMouseCoordsInternal() - m_sMotionBatch.origin) * m_sMotionBatch.scale;
+    m_sMotionBatch.time      = time;
+
+    g_pSeatManager->sendPointerMotion(time, m_sMotionBatch.sentLocal);
+
+    if (m_sMotionBatch.pending)
+        return true;
+
+    m_sMotionBatch.pending = true;
+    g_pEventLoopManager->doLater([]() {
+        if (g_pInputManager)
+            g_pInputManager->flushCoalescedMotion();
+    });
+
+    return true;
+}
+
+void CInputManager::flushCoalescedMotion() {
+    if (!m_sMotionBatch.pending)
+        return;
+
+    m_sMotionBatch.pending  = false;
+    m_sMotionBatch.flushing = true;
+
+    mouseMoveUnified(m_sMotionBatch.time);
+
+    m_sMotionBatch.flushing = false;
+}
+
 void CInputManager::onMouseWarp(IPointer::SMotionAbsoluteEvent e) {
     g_pPointerManager->warpAbsolute(e.absolute, e.device);
 
@@ -148,6 +187,8 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
     if (MOUSECOORDSFLOORED == m_vLastCursorPosFloored && !refocus)
         return;
 
+    m_sMotionBatch.surface.reset();
+
     static auto PFOLLOWMOUSE      = CConfigValue<Hyprlang::INT>("input:follow_mouse");
     static auto PMOUSEREFOCUS     = CConfigValue<Hyprlang::INT>("input:mouse_refocus");
     static auto PFOLLOWONDND      = CConfigValue<Hyprlang::INT>("misc:always_follow_on_dnd");
@@ -432,6 +473,11 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
     if (pFoundWindow && pFoundWindow->m_bIsX11) // for x11 force scale zero
         surfaceLocal = surfaceLocal * pFoundWindow->m_fX11SurfaceScaledBy;
 
+    // remember how to map global coords into foundSurface, for coalesced motion
+    m_sMotionBatch.surface = foundSurface;
+    m_sMotionBatch.scale   = pFoundWindow && pFoundWindow->m_bIsX11 ? pFoundWindow->m_fX11SurfaceScaledBy : 1.0;
+    m_sMotionBatch.origin  = mouseCoords - surfaceLocal / m_sMotionBatch.scale;
+
     bool allowKeyboardRefocus = true;
 
     if (!refocus && g_pCompositor->m_pLastFocus) {
@@ -487,7 +533,7 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
             if (FOLLOWMOUSE != 0 || pFoundWindow == g_pCompositor->m_pLastWindow)
                 g_pSeatManager->setPointerFocus(foundSurface, surfaceLocal);
 
-            if (g_pSeatManager->state.pointerFocus == foundSurface)
+            if (g_pSeatManager->state.pointerFocus == foundSurface && (!m_sMotionBatch.flushing || surfaceLocal != m_sMotionBatch.sentLocal))
                 g_pSeatManager->sendPointerMotion(time, surfaceLocal);
 
             m_bLastFocusOnLS = false;
@@ -527,10 +573,16 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
     }
 
     g_pSeatManager->setPointerFocus(foundSurface, surfaceLocal);
-    g_pSeatManager->sendPointerMotion(time, surfaceLocal);
+
+    // the coalesced motion already told the client where the cursor is
+    if (!m_sMotionBatch.flushing || surfaceLocal != m_sMotionBatch.sentLocal)
+        g_pSeatManager->sendPointerMotion(time, surfaceLocal);
 }
 
 void CInputManager::onMouseButton(IPointer::SButtonEvent e) {
+    // buttons have to go to whatever is under the cursor now
+    flushCoalescedMotion();
+
     EMIT_HOOK_EVENT_CANCELLABLE("mouseButton", e);
 
     m_tmrLastCursorMovement.reset();
@@ -662,7 +714,8 @@ void CInputManager::processMouseDownNormal(const IPointer::SButtonEvent& e) {
     static auto PRESIZEONBORDER   = CConfigValue<Hyprlang::INT>("general:resize_on_border");
     static auto PBORDERSIZE       = CConfigValue<Hyprlang::INT>("general:border_size");
     static auto PBORDERGRABEXTEND = CConfigValue<Hyprlang::INT>("general:extend_border_grab_area");
-    const auto  BORDER_GRAB_AREA  = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
+    static auto PBORDERGRABAREA   = CDerivedConfigValue<int64_t>([] { return *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0; });
+    const auto  BORDER_GRAB_AREA  = *PBORDERGRABAREA;
 
     if (!PASS && !*PPASSMOUSE)
         return;
@@ -764,6 +817,8 @@ void CInputManager::onMouseWheel(IPointer::SAxisEvent e) {
     const bool  ISTOUCHPADSCROLL = *PTOUCHPADSCROLLFACTOR <= 0.f || e.source == WL_POINTER_AXIS_SOURCE_FINGER;
     auto        factor           = ISTOUCHPADSCROLL ? *PTOUCHPADSCROLLFACTOR : *PINPUTSCROLLFACTOR;
 
+    flushCoalescedMotion();
+
     const auto  EMAP = std::unordered_map<std::string, std::any>{{"event", e}};
     EMIT_HOOK_EVENT_CANCELLABLE("mouseAxis", EMAP);
 
@@ -943,10 +998,34 @@ void CInputManager::setupKeyboard(SP<IKeyboard> keeb) {
 }
 
 void CInputManager::setKeyboardLayout() {
+    // kick off xkbcomp for every keymap we're about to need, so they compile in parallel.
+    // An empty device name reads the global input:kb_* values, which the keybind manager uses.
+    const auto RULE = [](const std::string& devname, const std::string& key) -> std::string {
+        if (!devname.empty())
+            return g_pConfigManager->getDeviceString(devname, key, "input:" + key);
+
+        const auto VAL = std::string{std::any_cast<Hyprlang::STRING>(g_pConfigManager->getHyprlangConfigValuePtr("input:" + key)->getValue())};
+        return VAL == STRVAL_EMPTY ? "" : VAL;
+    };
+
+    const auto PREFETCH = [&RULE](const std::string& devname) {
+        g_pKeymapCache->prefetch({RULE(devname, "kb_layout"), RULE(devname, "kb_model"), RULE(devname, "kb_variant"), RULE(devname, "kb_options"), RULE(devname, "kb_rules")},
+                                 RULE(devname, "kb_file"));
+    };
+
+    for (auto const& k : m_vKeyboards) {
+        if (!k->keymapOverridden)
+            PREFETCH(k->hlName);
+    }
+
+    PREFETCH("");
+
     for (auto const& k : m_vKeyboards)
         applyConfigToKeyboard(k);
 
     g_pKeybindManager->updateXKBTranslationState();
+
+    g_pKeymapCache->prune();
 }
 
 void CInputManager::applyConfigToKeyboard(SP<IKeyboard> pKeyboard) {
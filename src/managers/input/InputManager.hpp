@@ -240,6 +240,20 @@ class CInputManager {
 
     void               mouseMoveUnified(uint32_t, bool refocus = false);
 
+    // input:coalesce_motion. Motion goes to the focused client right away, the focus pipeline runs once per loop iteration.
+    bool               sendCoalescedMotion(uint32_t time);
+    void               flushCoalescedMotion();
+
+    struct {
+        WP<CWLSurfaceResource> surface; // what the last full pass mapped coords for
+        Vector2D               origin;  // global coords of surface-local 0,0
+        double                 scale = 1.0;
+        Vector2D               sentLocal;
+        uint32_t               time     = 0;
+        bool                   pending  = false;
+        bool                   flushing = false;
+    } m_sMotionBatch;
+
     SP<CTabletTool>    ensureTabletToolPresent(SP<Aquamarine::ITabletTool>);
 
     void               applyConfigToKeyboard(SP<IKeyboard>);
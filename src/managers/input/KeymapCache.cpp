@@ -0,0 +1,201 @@
+#include "KeymapCache.hpp"
+#include "../../defines.hpp"
+#include "../../helpers/MiscFunctions.hpp"
+#include "../../config/ConfigManager.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+CCompiledKeymap::~CCompiledKeymap() {
+    if (keymap)
+        xkb_keymap_unref(keymap);
+
+    if (fd >= 0)
+        close(fd);
+}
+
+uint32_t CCompiledKeymap::size() const {
+    return string.length() + 1;
+}
+
+// one read-only fd for everyone: a sealed memfd, or a read-only shm fd where memfds can't be sealed
+static int createKeymapFD(const std::string& keymap) {
+    const size_t SIZE = keymap.length() + 1;
+
+#ifdef MFD_ALLOW_SEALING
+    int fd = memfd_create("hyprland-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd >= 0) {
+        size_t written = 0;
+        while (written < SIZE) {
+            const auto RET = write(fd, keymap.c_str() + written, SIZE - written);
+            if (RET < 0 && errno == EINTR)
+                continue;
+            if (RET <= 0)
+                break;
+            written += RET;
+        }
+
+        if (written == SIZE && fcntl(fd, F_ADD_SEALS, F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE) == 0)
+            return fd;
+
+        Debug::log(WARN, "KeymapCache: failed to fill or seal a keymap memfd, falling back to shm");
+        close(fd);
+    }
+#endif
+
+    int rw = -1, ro = -1;
+    if (!allocateSHMFilePair(SIZE, &rw, &ro))
+        return -1;
+
+    auto dest = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, rw, 0);
+    close(rw);
+
+    if (dest == MAP_FAILED) {
+        close(ro);
+        return -1;
+    }
+
+    memcpy(dest, keymap.c_str(), SIZE);
+    munmap(dest, SIZE);
+
+    return ro;
+}
+
+CKeymapCache::~CKeymapCache() {
+    // in-flight compiles hand over raw keymaps, don't leak them
+    for (auto& [k, e] : m_mEntries) {
+        if (!e.pending.valid())
+            continue;
+
+        auto result = e.pending.get();
+        if (result.keymap)
+            xkb_keymap_unref(result.keymap);
+        if (result.fd >= 0)
+            close(result.fd);
+    }
+}
+
+CKeymapCache::SCompileResult CKeymapCache::compile(IKeyboard::SStringRuleNames rules, std::string fileContents) {
+    SCompileResult result;
+
+    // contexts aren't thread-safe, so every compile gets its own. The keymap keeps it alive.
+    const auto CONTEXT = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    if (!CONTEXT)
+        return result;
+
+    if (!fileContents.empty()) {
+        result.keymap = xkb_keymap_new_from_string(CONTEXT, fileContents.c_str(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+
+        if (!result.keymap)
+            Debug::log(ERR, "KeymapCache: input:kb_file failed to compile, falling back to the rules");
+    }
+
+    if (!result.keymap) {
+        const xkb_rule_names XKBRULES = {
+            .rules   = rules.rules.c_str(),
+            .model   = rules.model.c_str(),
+            .layout  = rules.layout.c_str(),
+            .variant = rules.variant.c_str(),
+            .options = rules.options.c_str(),
+        };
+
+        result.keymap = xkb_keymap_new_from_names(CONTEXT, &XKBRULES, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    }
+
+    xkb_context_unref(CONTEXT);
+
+    if (!result.keymap)
+        return result;
+
+    const auto KEYMAPSTR = xkb_keymap_get_as_string(result.keymap, XKB_KEYMAP_FORMAT_TEXT_V1);
+    result.string        = KEYMAPSTR;
+    free(KEYMAPSTR);
+
+    result.fd = createKeymapFD(result.string);
+
+    return result;
+}
+
+CKeymapCache::SEntry* CKeymapCache::entryFor(const IKeyboard::SStringRuleNames& rules, const std::string& filePath) {
+    std::string fileContents;
+
+    if (!filePath.empty()) {
+        const auto PATH = absolutePath(filePath, g_pConfigManager->configCurrentPath);
+
+        if (std::ifstream file(PATH); file.good()) {
+            std::stringstream buf;
+            buf << file.rdbuf();
+            fileContents = buf.str();
+        } else
+            Debug::log(ERR, "Cannot open input:kb_file= file for reading");
+    }
+
+    // the file is keyed on its contents, so editing it invalidates the entry
+    const auto KEY = std::format("{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{:x}", rules.rules, rules.model, rules.layout, rules.variant, rules.options,
+                                 fileContents.empty() ? 0 : std::hash<std::string>{}(fileContents));
+
+    if (const auto IT = m_mEntries.find(KEY); IT != m_mEntries.end())
+        return &IT->second;
+
+    auto& entry   = m_mEntries[KEY];
+    entry.pending = std::async(std::launch::async, &CKeymapCache::compile, rules, std::move(fileContents));
+
+    return &entry;
+}
+
+void CKeymapCache::prefetch(const IKeyboard::SStringRuleNames& rules, const std::string& filePath) {
+    entryFor(rules, filePath);
+}
+
+SP<CCompiledKeymap> CKeymapCache::get(const IKeyboard::SStringRuleNames& rules, const std::string& filePath) {
+    const auto ENTRY = entryFor(rules, filePath);
+
+    if (ENTRY->pending.valid()) {
+        auto result = ENTRY->pending.get();
+
+        if (!result.keymap) {
+            ENTRY->failed = true;
+            return nullptr;
+        }
+
+        ENTRY->keymap         = makeShared<CCompiledKeymap>();
+        ENTRY->keymap->keymap = result.keymap;
+        ENTRY->keymap->string = std::move(result.string);
+        ENTRY->keymap->fd     = result.fd;
+
+        Debug::log(LOG, "KeymapCache: compiled keymap for layout {} with variant {} (rules: {}, model: {}, options: {})", rules.layout, rules.variant, rules.rules,
+                   rules.model, rules.options);
+    }
+
+    return ENTRY->failed ? nullptr : ENTRY->keymap;
+}
+
+SP<CCompiledKeymap> CKeymapCache::fromKeymap(xkb_keymap* keymap) {
+    if (!keymap)
+        return nullptr;
+
+    const auto  KEYMAPSTR = xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1);
+    std::string str       = KEYMAPSTR;
+    free(KEYMAPSTR);
+
+    const auto KEY = std::format("string\x1f{:x}", std::hash<std::string>{}(str));
+
+    if (const auto IT = m_mEntries.find(KEY); IT != m_mEntries.end() && IT->second.keymap && IT->second.keymap->string == str)
+        return IT->second.keymap;
+
+    auto compiled    = makeShared<CCompiledKeymap>();
+    compiled->keymap = xkb_keymap_ref(keymap);
+    compiled->fd     = createKeymapFD(str);
+    compiled->string = std::move(str);
+
+    m_mEntries[KEY].keymap = compiled;
+
+    return compiled;
+}
+
+void CKeymapCache::prune() {
+    std::erase_if(m_mEntries, [](const auto& e) { return !e.second.pending.valid() && (e.second.failed || e.second.keymap.strongRef() <= 1); });
+}
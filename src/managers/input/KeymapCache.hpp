@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <future>
+#include <unordered_map>
+#include <xkbcommon/xkbcommon.h>
+#include "../../devices/IKeyboard.hpp"
+#include "../../helpers/memory/Memory.hpp"
+
+/*
+    A compiled keymap, shared by every keyboard (and the keybind manager) using the same rules.
+    fd is a sealed, read-only memfd with the serialized keymap, sent as-is to all seat clients.
+*/
+class CCompiledKeymap {
+  public:
+    ~CCompiledKeymap();
+
+    xkb_keymap* keymap = nullptr;
+    std::string string;
+    int         fd = -1;
+
+    // size to send with wl_keyboard.keymap, including the terminating NUL
+    uint32_t size() const;
+};
+
+/*
+    Process-wide keymap cache, keyed on (rules, model, layout, variant, options, kb_file contents).
+    xkbcomp runs on worker threads: prefetch() starts compiling, and get() only blocks if the
+    keymap is still in flight. Compiled keymaps are only ever touched on the main thread.
+*/
+class CKeymapCache {
+  public:
+    ~CKeymapCache();
+
+    // starts compiling in the background if the keymap isn't cached yet
+    void                prefetch(const IKeyboard::SStringRuleNames& rules, const std::string& filePath = "");
+
+    // nullptr if neither kb_file nor the rules compile
+    SP<CCompiledKeymap> get(const IKeyboard::SStringRuleNames& rules, const std::string& filePath = "");
+
+    // for keymaps compiled elsewhere, e.g. sent by virtual keyboards. Shares the memfd with identical keymaps.
+    SP<CCompiledKeymap> fromKeymap(xkb_keymap* keymap);
+
+    // drops keymaps no keyboard holds anymore
+    void                prune();
+
+  private:
+    struct SCompileResult {
+        xkb_keymap* keymap = nullptr;
+        std::string string;
+        int         fd = -1;
+    };
+
+    struct SEntry {
+        std::future<SCompileResult> pending;
+        SP<CCompiledKeymap>         keymap;
+        bool                        failed = false;
+    };
+
+    SEntry*                                 entryFor(const IKeyboard::SStringRuleNames& rules, const std::string& filePath);
+    static SCompileResult                   compile(IKeyboard::SStringRuleNames rules, std::string fileContents);
+
+    std::unordered_map<std::string, SEntry> m_mEntries;
+};
+
+inline std::unique_ptr<CKeymapCache> g_pKeymapCache;
@@ -1,5 +1,6 @@
 #include "ForeignToplevel.hpp"
 #include "../Compositor.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
 
 CForeignToplevelHandle::CForeignToplevelHandle(SP<CExtForeignToplevelHandleV1> resource_, PHLWINDOW pWindow_) : resource(resource_), pWindow(pWindow_) {
     if (!resource_->resource())
@@ -17,6 +18,29 @@ PHLWINDOW CForeignToplevelHandle::window() {
     return pWindow.lock();
 }
 
+void CForeignToplevelHandle::markDirty(uint8_t what) {
+    dirty |= what;
+    PROTO::foreignToplevel->scheduleFlush();
+}
+
+void CForeignToplevelHandle::flush() {
+    if (!dirty)
+        return;
+
+    const auto DIRTY   = std::exchange(dirty, 0);
+    const auto PWINDOW = pWindow.lock();
+
+    if (closed || !PWINDOW)
+        return;
+
+    if (DIRTY & DIRTY_APPID)
+        resource->sendAppId(PWINDOW->m_szClass.c_str());
+    if (DIRTY & DIRTY_TITLE)
+        resource->sendTitle(PWINDOW->m_szTitle.c_str());
+
+    resource->sendDone();
+}
+
 CForeignToplevelList::CForeignToplevelList(SP<CExtForeignToplevelListV1> resource_) : resource(resource_) {
     if (!resource_->resource())
         return;
@@ -78,8 +102,7 @@ void CForeignToplevelList::onTitle(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->resource->sendTitle(pWindow->m_szTitle.c_str());
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandle::DIRTY_TITLE);
 }
 
 void CForeignToplevelList::onClass(PHLWINDOW pWindow) {
@@ -90,8 +113,7 @@ void CForeignToplevelList::onClass(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->resource->sendAppId(pWindow->m_szClass.c_str());
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandle::DIRTY_APPID);
 }
 
 void CForeignToplevelList::onUnmap(PHLWINDOW pWindow) {
@@ -104,6 +126,7 @@ void CForeignToplevelList::onUnmap(PHLWINDOW pWindow) {
 
     H->resource->sendClosed();
     H->closed = true;
+    H->dirty  = 0;
 }
 
 bool CForeignToplevelList::good() {
@@ -167,3 +190,23 @@ void CForeignToplevelProtocol::destroyHandle(CForeignToplevelHandle* handle) {
 bool CForeignToplevelProtocol::windowValidForForeign(PHLWINDOW pWindow) {
     return validMapped(pWindow) && !pWindow->isX11OverrideRedirect();
 }
+
+void CForeignToplevelProtocol::scheduleFlush() {
+    if (flushScheduled)
+        return;
+
+    flushScheduled = true;
+
+    g_pEventLoopManager->doLater([]() {
+        if (PROTO::foreignToplevel)
+            PROTO::foreignToplevel->flushDirtyHandles();
+    });
+}
+
+void CForeignToplevelProtocol::flushDirtyHandles() {
+    flushScheduled = false;
+
+    for (auto const& h : m_vHandles) {
+        h->flush();
+    }
+}
@@ -18,7 +18,19 @@ class CForeignToplevelHandle {
     PHLWINDOWREF                    pWindow;
     bool                            closed = false;
 
+    enum eDirty : uint8_t {
+        DIRTY_TITLE = (1 << 0),
+        DIRTY_APPID = (1 << 1),
+    };
+
+    // changes not sent yet, flushed with a single done once per event loop iteration
+    uint8_t dirty = 0;
+
+    void    markDirty(uint8_t what);
+    void    flush();
+
     friend class CForeignToplevelList;
+    friend class CForeignToplevelProtocol;
 };
 
 class CForeignToplevelList {
@@ -51,6 +63,10 @@ class CForeignToplevelProtocol : public IWaylandProtocol {
     void onManagerResourceDestroy(CForeignToplevelList* mgr);
     void destroyHandle(CForeignToplevelHandle* handle);
     bool windowValidForForeign(PHLWINDOW pWindow);
+    void scheduleFlush();
+    void flushDirtyHandles();
+
+    bool flushScheduled = false;
 
     //
     std::vector<UP<CForeignToplevelList>>   m_vManagers;
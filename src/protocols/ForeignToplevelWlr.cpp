@@ -3,6 +3,7 @@
 #include "../Compositor.hpp"
 #include "protocols/core/Output.hpp"
 #include "render/Renderer.hpp"
+#include "managers/eventLoop/EventLoopManager.hpp"
 
 CForeignToplevelHandleWlr::CForeignToplevelHandleWlr(SP<CZwlrForeignToplevelHandleV1> resource_, PHLWINDOW pWindow_) : resource(resource_), pWindow(pWindow_) {
     if (!resource_->resource())
@@ -166,6 +167,33 @@ void CForeignToplevelHandleWlr::sendState() {
     wl_array_release(&state);
 }
 
+void CForeignToplevelHandleWlr::markDirty(uint8_t what) {
+    dirty |= what;
+    PROTO::foreignToplevelWlr->scheduleFlush();
+}
+
+void CForeignToplevelHandleWlr::flush() {
+    if (!dirty)
+        return;
+
+    const auto DIRTY   = std::exchange(dirty, 0);
+    const auto PWINDOW = pWindow.lock();
+
+    if (closed || !PWINDOW)
+        return;
+
+    if (DIRTY & DIRTY_APPID)
+        resource->sendAppId(PWINDOW->m_szClass.c_str());
+    if (DIRTY & DIRTY_TITLE)
+        resource->sendTitle(PWINDOW->m_szTitle.c_str());
+    if (const auto PMONITOR = PWINDOW->m_pMonitor.lock(); PMONITOR && (DIRTY & DIRTY_OUTPUT))
+        sendMonitor(PMONITOR);
+    if (DIRTY & DIRTY_STATE)
+        sendState();
+
+    resource->sendDone();
+}
+
 CForeignToplevelWlrManager::CForeignToplevelWlrManager(SP<CZwlrForeignToplevelManagerV1> resource_) : resource(resource_) {
     if (!resource_->resource())
         return;
@@ -229,8 +257,7 @@ void CForeignToplevelWlrManager::onTitle(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->resource->sendTitle(pWindow->m_szTitle.c_str());
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandleWlr::DIRTY_TITLE);
 }
 
 void CForeignToplevelWlrManager::onClass(PHLWINDOW pWindow) {
@@ -241,8 +268,7 @@ void CForeignToplevelWlrManager::onClass(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->resource->sendAppId(pWindow->m_szClass.c_str());
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandleWlr::DIRTY_APPID);
 }
 
 void CForeignToplevelWlrManager::onUnmap(PHLWINDOW pWindow) {
@@ -256,6 +282,7 @@ void CForeignToplevelWlrManager::onUnmap(PHLWINDOW pWindow) {
     H->resource->sendClosed();
     H->resource->sendDone();
     H->closed = true;
+    H->dirty  = 0;
 }
 
 void CForeignToplevelWlrManager::onMoveMonitor(PHLWINDOW pWindow) {
@@ -266,13 +293,7 @@ void CForeignToplevelWlrManager::onMoveMonitor(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    const auto PMONITOR = pWindow->m_pMonitor.lock();
-
-    if (!PMONITOR)
-        return;
-
-    H->sendMonitor(PMONITOR);
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandleWlr::DIRTY_OUTPUT);
 }
 
 void CForeignToplevelWlrManager::onFullscreen(PHLWINDOW pWindow) {
@@ -283,18 +304,15 @@ void CForeignToplevelWlrManager::onFullscreen(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->sendState();
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandleWlr::DIRTY_STATE);
 }
 
 void CForeignToplevelWlrManager::onNewFocus(PHLWINDOW pWindow) {
     if (finished)
         return;
 
-    if (const auto HOLD = handleForWindow(lastFocus.lock()); HOLD) {
-        HOLD->sendState();
-        HOLD->resource->sendDone();
-    }
+    if (const auto HOLD = handleForWindow(lastFocus.lock()); HOLD)
+        HOLD->markDirty(CForeignToplevelHandleWlr::DIRTY_STATE);
 
     lastFocus = pWindow;
 
@@ -302,8 +320,7 @@ void CForeignToplevelWlrManager::onNewFocus(PHLWINDOW pWindow) {
     if (!H || H->closed)
         return;
 
-    H->sendState();
-    H->resource->sendDone();
+    H->markDirty(CForeignToplevelHandleWlr::DIRTY_STATE);
 }
 
 bool CForeignToplevelWlrManager::good() {
@@ -393,6 +410,26 @@ void CForeignToplevelWlrProtocol::destroyHandle(CForeignToplevelHandleWlr* handl
     std::erase_if(m_vHandles, [&](const auto& other) { return other.get() == handle; });
 }
 
+void CForeignToplevelWlrProtocol::scheduleFlush() {
+    if (flushScheduled)
+        return;
+
+    flushScheduled = true;
+
+    g_pEventLoopManager->doLater([]() {
+        if (PROTO::foreignToplevelWlr)
+            PROTO::foreignToplevelWlr->flushDirtyHandles();
+    });
+}
+
+void CForeignToplevelWlrProtocol::flushDirtyHandles() {
+    flushScheduled = false;
+
+    for (auto const& h : m_vHandles) {
+        h->flush();
+    }
+}
+
 PHLWINDOW CForeignToplevelWlrProtocol::windowFromHandleResource(wl_resource* res) {
     for (auto const& h : m_vHandles) {
         if (h->res() != res)
@@ -25,7 +25,21 @@ class CForeignToplevelHandleWlr {
     void                             sendMonitor(PHLMONITOR pMonitor);
     void                             sendState();
 
+    enum eDirty : uint8_t {
+        DIRTY_TITLE  = (1 << 0),
+        DIRTY_APPID  = (1 << 1),
+        DIRTY_STATE  = (1 << 2),
+        DIRTY_OUTPUT = (1 << 3),
+    };
+
+    // changes not sent yet, flushed with a single done once per event loop iteration
+    uint8_t dirty = 0;
+
+    void    markDirty(uint8_t what);
+    void    flush();
+
     friend class CForeignToplevelWlrManager;
+    friend class CForeignToplevelWlrProtocol;
 };
 
 class CForeignToplevelWlrManager {
@@ -64,6 +78,10 @@ class CForeignToplevelWlrProtocol : public IWaylandProtocol {
     void onManagerResourceDestroy(CForeignToplevelWlrManager* mgr);
     void destroyHandle(CForeignToplevelHandleWlr* handle);
     bool windowValidForForeign(PHLWINDOW pWindow);
+    void scheduleFlush();
+    void flushDirtyHandles();
+
+    bool flushScheduled = false;
 
     //
     std::vector<UP<CForeignToplevelWlrManager>> m_vManagers;
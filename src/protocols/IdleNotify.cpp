@@ -35,6 +35,8 @@ bool CExtIdleNotification::good() {
 }
 
 void CExtIdleNotification::updateTimer() {
+    lastActivity = std::chrono::steady_clock::now();
+
     if (PROTO::idle->isInhibited)
         timer->updateTimeout(std::nullopt);
     else
@@ -42,6 +44,13 @@ void CExtIdleNotification::updateTimer() {
 }
 
 void CExtIdleNotification::onTimerFired() {
+    // activity since arming only moved lastActivity, push the timer out by what's left
+    const auto IDLEFOR = std::chrono::steady_clock::now() - lastActivity;
+    if (IDLEFOR < std::chrono::milliseconds(timeoutMs)) {
+        timer->updateTimeout(std::chrono::milliseconds(timeoutMs) - IDLEFOR);
+        return;
+    }
+
     resource->sendIdled();
     idled = true;
 }
@@ -50,8 +59,12 @@ void CExtIdleNotification::onActivity() {
     if (idled)
         resource->sendResumed();
 
-    idled = false;
-    updateTimer();
+    idled        = false;
+    lastActivity = std::chrono::steady_clock::now();
+
+    // input comes in at device rates, don't re-arm an armed timer for every event
+    if (PROTO::idle->isInhibited || !timer->armed())
+        updateTimer();
 }
 
 CIdleNotifyProtocol::CIdleNotifyProtocol(const wl_interface* iface, const int& ver, const std::string& name) : IWaylandProtocol(iface, ver, name) {
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <chrono>
 #include "WaylandProtocol.hpp"
 #include "ext-idle-notify-v1.hpp"
 
@@ -18,13 +19,14 @@ class CExtIdleNotification {
     void onActivity();
 
   private:
-    SP<CExtIdleNotificationV1> resource;
-    uint32_t                   timeoutMs = 0;
-    SP<CEventLoopTimer>        timer;
+    SP<CExtIdleNotificationV1>            resource;
+    uint32_t                              timeoutMs = 0;
+    SP<CEventLoopTimer>                   timer;
 
-    bool                       idled = false;
+    bool                                  idled = false;
+    std::chrono::steady_clock::time_point lastActivity;
 
-    void                       updateTimer();
+    void                                  updateTimer();
 };
 
 class CIdleNotifyProtocol : public IWaylandProtocol {
@@ -2,6 +2,7 @@
 #include "../Compositor.hpp"
 #include "../managers/SeatManager.hpp"
 #include "../devices/IKeyboard.hpp"
+#include "../managers/input/KeymapCache.hpp"
 #include <sys/mman.h>
 #include "core/Compositor.hpp"
 #include <cstring>
@@ -33,25 +34,9 @@ void CInputMethodKeyboardGrabV2::sendKeyboardData(SP<IKeyboard> keyboard) {
 
     pLastKeyboard = keyboard;
 
-    int keymapFD = allocateSHMFile(keyboard->xkbKeymapString.length() + 1);
-    if (keymapFD < 0) {
-        LOGM(ERR, "Failed to create a keymap file for keyboard grab");
-        return;
-    }
-
-    void* data = mmap(nullptr, keyboard->xkbKeymapString.length() + 1, PROT_READ | PROT_WRITE, MAP_SHARED, keymapFD, 0);
-    if (data == MAP_FAILED) {
-        LOGM(ERR, "Failed to mmap a keymap file for keyboard grab");
-        close(keymapFD);
-        return;
-    }
-
-    memcpy(data, keyboard->xkbKeymapString.c_str(), keyboard->xkbKeymapString.length());
-    munmap(data, keyboard->xkbKeymapString.length() + 1);
-
-    resource->sendKeymap(WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1, keymapFD, keyboard->xkbKeymapString.length() + 1);
-
-    close(keymapFD);
+    // the compiled keymap's fd is sealed and read-only, so it can go out as-is
+    if (keyboard->compiledKeymap)
+        resource->sendKeymap(WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1, keyboard->compiledKeymap->fd, keyboard->compiledKeymap->size());
 
     sendMods(keyboard->modifiersState.depressed, keyboard->modifiersState.latched, keyboard->modifiersState.locked, keyboard->modifiersState.group);
 
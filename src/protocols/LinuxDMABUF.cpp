@@ -5,6 +5,7 @@
 #include "../helpers/MiscFunctions.hpp"
 #include <sys/mman.h>
 #include <xf86drm.h>
+#include <drm_fourcc.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include "core/Compositor.hpp"
@@ -352,6 +353,7 @@ void CLinuxDMABUFFeedbackResource::sendDefaultFeedback() {
     resource->sendDone();
 
     lastFeedbackWasScanout = false;
+    scanoutMonitor.reset();
 }
 
 CLinuxDMABUFResource::CLinuxDMABUFResource(SP<CZwpLinuxDmabufV1> resource_) : resource(resource_) {
@@ -558,6 +560,47 @@ void CLinuxDMABufV1Protocol::destroyResource(CLinuxDMABuffer* resource) {
     std::erase_if(m_vBuffers, [&](const auto& other) { return other.get() == resource; });
 }
 
+bool CLinuxDMABufV1Protocol::canScanout(PHLMONITOR pMonitor, uint32_t format, uint64_t modifier) {
+    const SDMABUFTranche* tranche = nullptr;
+
+    if (formatTable) {
+        for (auto const& [mon, t] : formatTable->monitorTranches) {
+            if (mon != pMonitor)
+                continue;
+
+            tranche = &t;
+            break;
+        }
+    }
+
+    // no tranche (yet), ask the output directly
+    const auto FORMATS = tranche ? tranche->formats : pMonitor->output->getRenderFormats();
+
+    for (auto const& fmt : FORMATS) {
+        if (fmt.drmFormat != format)
+            continue;
+
+        // implicit modifiers can't be checked here, leave those to the test commit
+        return modifier == DRM_FORMAT_MOD_INVALID || std::find(fmt.modifiers.begin(), fmt.modifiers.end(), modifier) != fmt.modifiers.end();
+    }
+
+    return false;
+}
+
+std::vector<CLinuxDMABufV1Protocol::SSurfaceFeedbackState> CLinuxDMABufV1Protocol::surfaceFeedbackStates() {
+    std::vector<SSurfaceFeedbackState> states;
+
+    for (auto const& f : m_vFeedbacks) {
+        // default feedback objects aren't tied to a surface
+        if (!f->surface)
+            continue;
+
+        states.emplace_back(SSurfaceFeedbackState{.surface = f->surface, .scanoutMonitor = f->lastFeedbackWasScanout ? f->scanoutMonitor : PHLMONITORREF{}});
+    }
+
+    return states;
+}
+
 void CLinuxDMABufV1Protocol::updateScanoutTranche(SP<CWLSurfaceResource> surface, PHLMONITOR pMonitor) {
     SP<CLinuxDMABUFFeedbackResource> feedbackResource;
     for (auto const& f : m_vFeedbacks) {
@@ -605,4 +648,5 @@ void CLinuxDMABufV1Protocol::updateScanoutTranche(SP<CWLSurfaceResource> surface
     feedbackResource->resource->sendDone();
 
     feedbackResource->lastFeedbackWasScanout = true;
+    feedbackResource->scanoutMonitor         = pMonitor;
 }
@@ -90,6 +90,7 @@ class CLinuxDMABUFFeedbackResource {
   private:
     SP<CZwpLinuxDmabufFeedbackV1> resource;
     bool                          lastFeedbackWasScanout = false;
+    PHLMONITORREF                 scanoutMonitor;
 
     friend class CLinuxDMABufV1Protocol;
 };
@@ -113,6 +114,17 @@ class CLinuxDMABufV1Protocol : public IWaylandProtocol {
     virtual void bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id);
     void         updateScanoutTranche(SP<CWLSurfaceResource> surface, PHLMONITOR pMonitor);
 
+    // whether a buffer with this format / modifier is in the monitor's scanout tranche
+    bool         canScanout(PHLMONITOR pMonitor, uint32_t format, uint64_t modifier);
+
+    struct SSurfaceFeedbackState {
+        WP<CWLSurfaceResource> surface;
+        PHLMONITORREF          scanoutMonitor; // null: the surface gets the renderer tranche
+    };
+
+    // for hyprctl
+    std::vector<SSurfaceFeedbackState> surfaceFeedbackStates();
+
   private:
     void destroyResource(CLinuxDMABUFResource* resource);
     void destroyResource(CLinuxDMABUFFeedbackResource* resource);
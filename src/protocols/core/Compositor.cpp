@@ -86,7 +86,7 @@ CWLSurfaceResource::CWLSurfaceResource(SP<CWlSurface> resource_) : resource(reso
         Vector2D newBufSize = pending.buffer ? pending.bufferSize : Vector2D{};
 
         if (oldBufSize != newBufSize || current.buffer != pending.buffer)
-            pending.bufferDamage = CBox{{}, {INT32_MAX, INT32_MAX}};
+            pending.fullDamage = true;
     });
 
     resource->setCommit([this](CWlSurface* r) {
@@ -156,6 +156,7 @@ void CWLSurfaceResource::destroy() {
         events.unmap.emit();
         unmap();
     }
+    invalidateSubsurfaceTree();
     events.destroy.emit();
     releaseBuffers(false);
     PROTO::compositor->destroyResource(this);
@@ -249,11 +250,11 @@ void CWLSurfaceResource::frame(timespec* now) {
 }
 
 void CWLSurfaceResource::resetRole() {
+    invalidateSubsurfaceTree();
     role = makeShared<CDefaultSurfaceRole>();
 }
 
-void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
-
+void CWLSurfaceResource::buildSubsurfaceTreeLevel(std::vector<SP<CWLSurfaceResource>> const& nodes, std::vector<WP<CWLSurfaceResource>>& out) {
     std::vector<SP<CWLSurfaceResource>> nodes2;
     nodes2.reserve(nodes.size() * 2);
 
@@ -271,18 +272,12 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        buildSubsurfaceTreeLevel(nodes2, out);
 
     nodes2.clear();
 
     for (auto const& n : nodes) {
-        Vector2D offset = {};
-        if (n->role->role() == SURFACE_ROLE_SUBSURFACE) {
-            auto subsurface = ((CSubsurfaceRole*)n->role.get())->subsurface.lock();
-            offset          = subsurface->posRelativeToParent();
-        }
-
-        fn(n, offset, data);
+        out.emplace_back(n);
     }
 
     for (auto const& n : nodes) {
@@ -296,30 +291,63 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        buildSubsurfaceTreeLevel(nodes2, out);
+}
+
+void CWLSurfaceResource::buildSubsurfaceTree(std::vector<WP<CWLSurfaceResource>>& out) {
+    buildSubsurfaceTreeLevel({self.lock()}, out);
+}
+
+Vector2D CWLSurfaceResource::subsurfaceOffset(CWLSurfaceResource* surf) {
+    if (surf->role->role() != SURFACE_ROLE_SUBSURFACE)
+        return {};
+
+    auto subsurface = ((CSubsurfaceRole*)surf->role.get())->subsurface.lock();
+    return subsurface ? subsurface->posRelativeToParent() : Vector2D{};
+}
+
+void CWLSurfaceResource::invalidateSubsurfaceTree() {
+    // every surface caches its own subtree, so mark all parents up to the root.
+    // depth is capped as clients may create cycles, see CWLSubsurfaceResource::posRelativeToParent
+    CWLSurfaceResource* surf = this;
+    for (size_t depth = 0; surf && depth < 64; ++depth) {
+        surf->subsurfaceTree.dirty = true;
+
+        if (surf->role->role() != SURFACE_ROLE_SUBSURFACE)
+            break;
+
+        auto subsurface = ((CSubsurfaceRole*)surf->role.get())->subsurface.lock();
+        surf            = subsurface && !subsurface->parent.expired() ? subsurface->parent.get() : nullptr;
+    }
 }
 
 void CWLSurfaceResource::breadthfirst(std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
-    std::vector<SP<CWLSurfaceResource>> surfs;
-    surfs.push_back(self.lock());
-    bfHelper(surfs, fn, data);
+    breadthfirst([&fn, data](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) { fn(surf, offset, data); });
 }
 
 std::pair<SP<CWLSurfaceResource>, Vector2D> CWLSurfaceResource::at(const Vector2D& localCoords, bool allowsInput) {
-    std::vector<std::pair<SP<CWLSurfaceResource>, Vector2D>> surfs;
-    breadthfirst([](SP<CWLSurfaceResource> surf, const Vector2D& offset,
-                    void* data) { ((std::vector<std::pair<SP<CWLSurfaceResource>, Vector2D>>*)data)->emplace_back(std::make_pair<>(surf, offset)); },
-                 &surfs);
+    if (subsurfaceTree.dirty && subsurfaceTree.walking <= 0) {
+        subsurfaceTree.nodes.clear();
+        buildSubsurfaceTree(subsurfaceTree.nodes);
+        subsurfaceTree.dirty = false;
+    }
+
+    // no callbacks run below, so walking the cached nodes directly is safe
+    for (auto const& node : subsurfaceTree.nodes | std::views::reverse) {
+        const auto SURF = node.lock();
+        if (!SURF)
+            continue;
+
+        const auto POS = subsurfaceOffset(SURF.get());
 
-    for (auto const& [surf, pos] : surfs | std::views::reverse) {
         if (!allowsInput) {
-            const auto BOX = CBox{pos, surf->current.size};
+            const auto BOX = CBox{POS, SURF->current.size};
             if (BOX.containsPoint(localCoords))
-                return {surf, localCoords - pos};
+                return {SURF, localCoords - POS};
         } else {
-            const auto REGION = surf->current.input.copy().intersect(CBox{{}, surf->current.size}).translate(pos);
+            const auto REGION = SURF->current.input.copy().intersect(CBox{{}, SURF->current.size}).translate(POS);
             if (REGION.containsPoint(localCoords))
-                return {surf, localCoords - pos};
+                return {SURF, localCoords - POS};
         }
     }
 
@@ -372,14 +400,12 @@ SP<CWlSurface> CWLSurfaceResource::getResource() {
 
 CBox CWLSurfaceResource::extends() {
     CRegion full = CBox{{}, current.size};
-    breadthfirst(
-        [](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* d) {
-            if (surf->role->role() != SURFACE_ROLE_SUBSURFACE)
-                return;
-
-            ((CRegion*)d)->add(CBox{offset, surf->current.size});
-        },
-        &full);
+    breadthfirst([&full](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) {
+        if (surf->role->role() != SURFACE_ROLE_SUBSURFACE)
+            return;
+
+        full.add(CBox{offset, surf->current.size});
+    });
     return full.getExtents();
 }
 
@@ -398,6 +424,15 @@ CRegion CWLSurfaceResource::accumulateCurrentBufferDamage() {
     if (!current.texture)
         return {};
 
+    auto damage = accumulateClientBufferDamage();
+
+    if (current.fullDamage)
+        damage.add(CBox{{}, current.bufferSize});
+
+    return damage;
+}
+
+CRegion CWLSurfaceResource::accumulateClientBufferDamage() {
     CRegion surfaceDamage = current.damage;
     if (current.viewport.hasDestination) {
         Vector2D scale = sourceSize() / current.viewport.destination;
@@ -412,6 +447,31 @@ CRegion CWLSurfaceResource::accumulateCurrentBufferDamage() {
     return surfaceDamage.scale(current.scale).transform(wlTransformToHyprutils(invertTransform(current.transform)), trc.x, trc.y).add(current.bufferDamage);
 }
 
+void CWLSurfaceResource::recordDamageHistory() {
+    // damage against another buffer size, or no buffer at all, doesn't map onto the current one
+    const bool CONTINUOUS    = current.texture && current.bufferSize == damageHistory.bufferSize;
+    damageHistory.bufferSize = current.bufferSize;
+
+    damageHistory.commits++;
+    damageHistory.damage[damageHistory.commits % damageHistory.damage.size()] = CONTINUOUS ? accumulateClientBufferDamage() : CRegion{CBox{{}, {INT32_MAX, INT32_MAX}}};
+}
+
+std::optional<CRegion> CWLSurfaceResource::damageSinceCommit(uint64_t commit) {
+    if (commit > damageHistory.commits || damageHistory.commits - commit > damageHistory.damage.size())
+        return std::nullopt;
+
+    CRegion damage;
+    for (uint64_t i = commit + 1; i <= damageHistory.commits; ++i) {
+        damage.add(damageHistory.damage[i % damageHistory.damage.size()]);
+    }
+
+    return damage;
+}
+
+uint64_t CWLSurfaceResource::commitCount() {
+    return damageHistory.commits;
+}
+
 void CWLSurfaceResource::lockPendingState() {
     stateLocks++;
 }
@@ -427,7 +487,8 @@ void CWLSurfaceResource::commitPendingState() {
     current                   = pending;
     pending.damage.clear();
     pending.bufferDamage.clear();
-    pending.newBuffer = false;
+    pending.newBuffer  = false;
+    pending.fullDamage = false;
 
     events.roleCommit.emit();
 
@@ -437,9 +498,18 @@ void CWLSurfaceResource::commitPendingState() {
     if (current.texture)
         current.texture->m_eTransform = wlTransformToHyprutils(current.transform);
 
+    recordDamageHistory();
+
     if (current.buffer && current.buffer->buffer) {
         const auto DAMAGE = accumulateCurrentBufferDamage();
-        current.buffer->buffer->update(DAMAGE);
+        current.buffer->buffer->updateForSurface(self.lock(), DAMAGE);
+
+        // shm buffers move to a fresh texture if their pool slot was last shown elsewhere
+        if (current.buffer->buffer->texture && current.texture != current.buffer->buffer->texture) {
+            current.texture               = current.buffer->buffer->texture;
+            current.texture->m_eTransform = wlTransformToHyprutils(current.transform);
+            pending.texture               = current.texture;
+        }
 
         // if the surface is a cursor, update the shm buffer
         // TODO: don't update the entire texture
@@ -463,16 +533,14 @@ void CWLSurfaceResource::commitPendingState() {
         events.commit.emit();
     } else {
         // send commit to all synced surfaces in this tree.
-        breadthfirst(
-            [](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* data) {
-                if (surf->role->role() == SURFACE_ROLE_SUBSURFACE) {
-                    auto subsurface = ((CSubsurfaceRole*)surf->role.get())->subsurface.lock();
-                    if (!subsurface->sync)
-                        return;
-                }
-                surf->events.commit.emit();
-            },
-            nullptr);
+        breadthfirst([](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) {
+            if (surf->role->role() == SURFACE_ROLE_SUBSURFACE) {
+                auto subsurface = ((CSubsurfaceRole*)surf->role.get())->subsurface.lock();
+                if (!subsurface->sync)
+                    return;
+            }
+            surf->events.commit.emit();
+        });
     }
 
     // for async buffers, we can only release the buffer once we are unrefing it from current.
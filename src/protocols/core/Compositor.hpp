@@ -11,6 +11,8 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <array>
+#include <optional>
 #include "../WaylandProtocol.hpp"
 #include "wayland.hpp"
 #include "../../helpers/signal/Signal.hpp"
@@ -98,8 +100,9 @@ class CWLSurfaceResource {
             Vector2D destination;
             CBox     source;
         } viewport;
-        bool rejected  = false;
-        bool newBuffer = false;
+        bool rejected   = false;
+        bool newBuffer  = false;
+        bool fullDamage = false; // the buffer changed size or identity, all of it counts as damaged
 
         //
         void reset() {
@@ -124,6 +127,9 @@ class CWLSurfaceResource {
 
     void                                   breadthfirst(std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data);
     CRegion                                accumulateCurrentBufferDamage();
+    std::optional<CRegion>                 damageSinceCommit(uint64_t commit); // nullopt if the history doesn't go back that far
+    uint64_t                               commitCount();
+    void                                   invalidateSubsurfaceTree();
     void                                   presentFeedback(timespec* when, PHLMONITOR pMonitor);
     void                                   lockPendingState();
     void                                   unlockPendingState();
@@ -132,6 +138,29 @@ class CWLSurfaceResource {
     // localCoords param is relative to 0,0 of this surface
     std::pair<SP<CWLSurfaceResource>, Vector2D> at(const Vector2D& localCoords, bool allowsInput = false);
 
+    // same order as the std::function variant, but walks the cached tree without allocating.
+    // fn is called as fn(const SP<CWLSurfaceResource>&, const Vector2D& offset)
+    template <typename F>
+    void breadthfirst(F&& fn) {
+        if (subsurfaceTree.walking > 0 && subsurfaceTree.dirty) {
+            // the tree changed under an outer walk, don't pull the nodes from under it
+            std::vector<WP<CWLSurfaceResource>> nodes;
+            buildSubsurfaceTree(nodes);
+            walkSubsurfaceTree(nodes, fn);
+            return;
+        }
+
+        if (subsurfaceTree.dirty) {
+            subsurfaceTree.nodes.clear();
+            buildSubsurfaceTree(subsurfaceTree.nodes);
+            subsurfaceTree.dirty = false;
+        }
+
+        subsurfaceTree.walking++;
+        walkSubsurfaceTree(subsurfaceTree.nodes, fn);
+        subsurfaceTree.walking--;
+    }
+
   private:
     SP<CWlSurface> resource;
     wl_client*     pClient = nullptr;
@@ -142,14 +171,46 @@ class CWLSurfaceResource {
 
     int           stateLocks = 0;
 
+    // buffer damage the client sent with each of the last commits, so shm pool slots
+    // coming back around only upload what changed since they were last shown
+    struct {
+        std::array<CRegion, 8> damage;
+        Vector2D               bufferSize;
+        uint64_t               commits = 0;
+    } damageHistory;
+
     void          destroy();
+    CRegion       accumulateClientBufferDamage();
+    void          recordDamageHistory();
     void          releaseBuffers(bool onlyCurrent = true);
     void          dropPendingBuffer();
     void          dropCurrentBuffer();
     void          commitPendingState();
-    void          bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data);
     void          updateCursorShm(CRegion damage = CBox{0, 0, INT16_MAX, INT16_MAX});
 
+    // flattened subsurface tree of this surface (including itself) in render order,
+    // rebuilt only after a subsurface is added, removed or restacked.
+    struct {
+        std::vector<WP<CWLSurfaceResource>> nodes;
+        bool                                dirty   = true;
+        int                                 walking = 0;
+    } subsurfaceTree;
+
+    void            buildSubsurfaceTree(std::vector<WP<CWLSurfaceResource>>& out);
+    static void     buildSubsurfaceTreeLevel(std::vector<SP<CWLSurfaceResource>> const& nodes, std::vector<WP<CWLSurfaceResource>>& out);
+    static Vector2D subsurfaceOffset(CWLSurfaceResource* surf);
+
+    template <typename F>
+    static void walkSubsurfaceTree(const std::vector<WP<CWLSurfaceResource>>& nodes, F& fn) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const auto SURF = nodes[i].lock();
+            if (!SURF)
+                continue;
+
+            fn(SURF, subsurfaceOffset(SURF.get()));
+        }
+    }
+
     friend class CWLPointerResource;
 };
 
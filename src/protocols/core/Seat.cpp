@@ -4,6 +4,7 @@
 #include "../../devices/IKeyboard.hpp"
 #include "../../devices/IHID.hpp"
 #include "../../managers/SeatManager.hpp"
+#include "../../managers/input/KeymapCache.hpp"
 #include "../../config/ConfigValue.hpp"
 #include <algorithm>
 
@@ -321,13 +322,15 @@ void CWLKeyboardResource::sendKeymap(SP<IKeyboard> keyboard) {
     if (!(PROTO::seat->currentCaps & eHIDCapabilityType::HID_INPUT_CAPABILITY_KEYBOARD))
         return;
 
+    const auto       KEYMAP = keyboard->compiledKeymap;
+
     std::string_view keymap;
     int              fd;
     uint32_t         size;
-    if (keyboard) {
-        keymap = keyboard->xkbKeymapString;
-        fd     = keyboard->xkbKeymapFD;
-        size   = keyboard->xkbKeymapString.length() + 1;
+    if (KEYMAP) {
+        keymap = KEYMAP->string;
+        fd     = KEYMAP->fd;
+        size   = KEYMAP->size();
     } else {
         fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
         if (fd < 0) {
@@ -338,17 +341,17 @@ void CWLKeyboardResource::sendKeymap(SP<IKeyboard> keyboard) {
     }
 
     if (keymap == lastKeymap) {
-        if (!keyboard)
+        if (!KEYMAP)
             close(fd);
         return;
     }
     lastKeymap = keymap;
 
-    const wl_keyboard_keymap_format format = keyboard ? WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 : WL_KEYBOARD_KEYMAP_FORMAT_NO_KEYMAP;
+    const wl_keyboard_keymap_format format = KEYMAP ? WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 : WL_KEYBOARD_KEYMAP_FORMAT_NO_KEYMAP;
 
     resource->sendKeymap(format, fd, size);
 
-    if (!keyboard)
+    if (!KEYMAP)
         close(fd);
 }
 
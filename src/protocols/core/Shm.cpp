@@ -3,6 +3,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <drm_fourcc.h>
+#include "Compositor.hpp"
 #include "../../render/Texture.hpp"
 #include "../types/WLBuffer.hpp"
 #include "../../Compositor.hpp"
@@ -21,7 +22,18 @@ CWLSHMBuffer::CWLSHMBuffer(SP<CWLSHMPoolResource> pool_, uint32_t id, int32_t of
     offset = offset_;
     opaque = NFormatUtils::isFormatOpaque(NFormatUtils::shmToDRM(fmt_));
 
-    texture = makeShared<CTexture>(NFormatUtils::shmToDRM(fmt), (uint8_t*)pool->data + offset, stride, size_);
+    slotKey = {offset, (int32_t)size_.x, (int32_t)size_.y, stride, fmt};
+
+    std::erase_if(pool->slots, [](const auto& e) { return e.second.texture.expired(); });
+
+    auto& slot = pool->slots[slotKey];
+    texture    = slot.texture.lock();
+
+    // clients cycling through the same pool slots keep their GL storage. The contents are uploaded on commit.
+    if (!texture) {
+        texture = makeShared<CTexture>(NFormatUtils::shmToDRM(fmt), nullptr, stride, size_);
+        slot    = {.texture = texture};
+    }
 
     resource = CWLBufferResource::create(makeShared<CWlBuffer>(pool_->resource->client(), 1, id));
 
@@ -79,6 +91,26 @@ void CWLSHMBuffer::update(const CRegion& damage) {
     texture->update(NFormatUtils::shmToDRM(fmt), (uint8_t*)pool->data + offset, stride, damage);
 }
 
+void CWLSHMBuffer::updateForSurface(SP<CWLSurfaceResource> surface, const CRegion& damage) {
+    auto&      slot        = pool->slots[slotKey];
+    const auto LASTSURFACE = slot.uploadedBy.lock();
+
+    // the slot moved to another surface, which may still be showing the texture. Don't change it under it.
+    if (LASTSURFACE && LASTSURFACE != surface && LASTSURFACE->current.texture == texture)
+        texture = makeShared<CTexture>(NFormatUtils::shmToDRM(fmt), nullptr, stride, size);
+
+    // the texture is as old as its last upload, the surface's damage history brings it up to date
+    std::optional<CRegion> changed;
+    if (slot.texture.lock() == texture && LASTSURFACE == surface)
+        changed = surface->damageSinceCommit(slot.uploadedAt);
+
+    update(changed.value_or(CBox{{}, size}));
+
+    slot.texture    = texture;
+    slot.uploadedBy = surface;
+    slot.uploadedAt = surface->commitCount();
+}
+
 CSHMPool::CSHMPool(int fd_, size_t size_) : fd(fd_), size(size_), data(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) {
     ;
 }
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <vector>
+#include <map>
 #include <cstdint>
 #include "../WaylandProtocol.hpp"
 #include "wayland.hpp"
@@ -16,6 +17,7 @@
 #include "../../helpers/math/Math.hpp"
 
 class CWLSHMPoolResource;
+class CWLSurfaceResource;
 
 class CSHMPool {
   public:
@@ -27,6 +29,24 @@ class CSHMPool {
     void*  data = nullptr;
 
     void   resize(size_t size);
+
+    // a buffer layout within the pool. Buffers recreated on the same slot share its texture.
+    struct SSlotKey {
+        int32_t  offset = 0, width = 0, height = 0, stride = 0;
+        uint32_t fmt = 0;
+
+        auto     operator<=>(const SSlotKey&) const = default;
+    };
+
+    struct SSlot {
+        WP<CTexture>           texture;
+
+        // the texture holds the slot's contents as of this surface's commit
+        WP<CWLSurfaceResource> uploadedBy;
+        uint64_t               uploadedAt = 0;
+    };
+
+    std::map<SSlotKey, SSlot> slots;
 };
 
 class CWLSHMBuffer : public IHLBuffer {
@@ -37,6 +57,7 @@ class CWLSHMBuffer : public IHLBuffer {
     virtual Aquamarine::eBufferCapability          caps();
     virtual Aquamarine::eBufferType                type();
     virtual void                                   update(const CRegion& damage);
+    virtual void                                   updateForSurface(SP<CWLSurfaceResource> surface, const CRegion& damage);
     virtual bool                                   isSynchronous();
     virtual Aquamarine::SSHMAttrs                  shm();
     virtual std::tuple<uint8_t*, uint32_t, size_t> beginDataPtr(uint32_t flags);
@@ -50,7 +71,8 @@ class CWLSHMBuffer : public IHLBuffer {
     SP<CSHMPool>                                   pool;
 
   private:
-    bool success = false;
+    bool               success = false;
+    CSHMPool::SSlotKey slotKey;
 
     struct {
         CHyprSignalListener bufferResourceDestroy;
@@ -44,6 +44,7 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
         }
 
         std::sort(parent->subsurfaces.begin(), parent->subsurfaces.end(), [](const auto& a, const auto& b) { return a->zIndex < b->zIndex; });
+        parent->invalidateSubsurfaceTree();
     });
 
     resource->setPlaceBelow([this](CWlSubsurface* r, wl_resource* surf) {
@@ -75,6 +76,7 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
         }
 
         std::sort(parent->subsurfaces.begin(), parent->subsurfaces.end(), [](const auto& a, const auto& b) { return a->zIndex < b->zIndex; });
+        parent->invalidateSubsurfaceTree();
     });
 
     listeners.commitSurface = surface->events.commit.registerListener([this](std::any d) {
@@ -94,6 +96,8 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
 
 CWLSubsurfaceResource::~CWLSubsurfaceResource() {
     events.destroy.emit();
+    if (parent)
+        parent->invalidateSubsurfaceTree();
     if (surface)
         surface->resetRole();
 }
@@ -101,6 +105,8 @@ CWLSubsurfaceResource::~CWLSubsurfaceResource() {
 void CWLSubsurfaceResource::destroy() {
     if (surface && surface->mapped)
         surface->unmap();
+    if (parent)
+        parent->invalidateSubsurfaceTree();
     events.destroy.emit();
     PROTO::subcompositor->destroyResource(this);
 }
@@ -187,6 +193,7 @@ CWLSubcompositorResource::CWLSubcompositorResource(SP<CWlSubcompositor> resource
         RESOURCE->self = RESOURCE;
         SURF->role     = makeShared<CSubsurfaceRole>(RESOURCE);
         PARENT->subsurfaces.emplace_back(RESOURCE);
+        PARENT->invalidateSubsurfaceTree();
 
         LOGM(LOG, "New wl_subsurface with id {} at {:x}", id, (uintptr_t)RESOURCE.get());
 
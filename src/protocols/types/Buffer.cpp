@@ -9,6 +9,10 @@ void IHLBuffer::sendRelease() {
     resource->sendRelease();
 }
 
+void IHLBuffer::updateForSurface(SP<CWLSurfaceResource> surface, const CRegion& damage) {
+    update(damage);
+}
+
 void IHLBuffer::lock() {
     nLocks++;
 }
@@ -54,6 +54,8 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
         RASSERT((status == GL_FRAMEBUFFER_COMPLETE), "Framebuffer incomplete, couldn't create! (FB status: {}, GL Error: 0x{:x})", status, (int)glGetError());
 
         Debug::log(LOG, "Framebuffer created, status {}", status);
+
+        g_pHyprOpenGL->m_sStats.framebufferAllocs++;
     }
 
     glBindTexture(GL_TEXTURE_2D, 0);
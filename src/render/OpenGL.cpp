@@ -12,6 +12,7 @@
 #include <fcntl.h>
 #include <gbm.h>
 #include <filesystem>
+#include <fstream>
 
 const std::vector<const char*> ASSET_PATHS = {
 #ifdef DATAROOTDIR
@@ -21,6 +22,19 @@ const std::vector<const char*> ASSET_PATHS = {
     "/usr/local/share",
 };
 
+// bump when the layout of cached program binaries changes
+constexpr uint32_t PROGRAM_CACHE_MAGIC   = 0x48505243; // HPRC
+constexpr uint32_t PROGRAM_CACHE_VERSION = 1;
+
+static uint64_t    fnv1a64(std::string_view data, uint64_t hash = 0xcbf29ce484222325ULL) {
+    for (auto const& c : data) {
+        hash ^= (uint8_t)c;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
 inline void loadGLProc(void* pProc, const char* name) {
     void* proc = (void*)eglGetProcAddress(name);
     if (proc == nullptr) {
@@ -342,6 +356,8 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_iDRMFD) {
     Debug::log(WARN, "!RENDERER: Using the legacy GLES2 renderer!");
 #endif
 
+    initProgramCache();
+
     initDRMFormats();
 
     initAssets();
@@ -572,6 +588,15 @@ void CHyprOpenGLImpl::logShaderError(const GLuint& shader, bool program) {
 }
 
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag, bool dynamic) {
+    // dynamic programs (the screen shader) change at runtime, don't litter the cache with them
+    const bool     CACHEABLE = !dynamic && m_sProgramCache.enabled;
+    const uint64_t HASH      = CACHEABLE ? fnv1a64(frag, fnv1a64(std::string_view{"\0", 1}, fnv1a64(vert))) : 0;
+
+    if (CACHEABLE) {
+        if (const auto CACHED = loadCachedProgram(HASH); CACHED)
+            return CACHED;
+    }
+
     auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert, dynamic);
     if (dynamic) {
         if (vertCompiled == 0)
@@ -590,6 +615,10 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
     auto prog = glCreateProgram();
     glAttachShader(prog, vertCompiled);
     glAttachShader(prog, fragCompiled);
+#ifndef GLES2
+    if (CACHEABLE)
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
     glLinkProgram(prog);
 
     glDetachShader(prog, vertCompiled);
@@ -610,6 +639,9 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
         RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
     }
 
+    if (CACHEABLE)
+        storeCachedProgram(HASH, prog);
+
     return prog;
 }
 
@@ -638,6 +670,142 @@ GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, std::string src, bool
     return shader;
 }
 
+struct SProgramCacheHeader {
+    uint32_t magic   = PROGRAM_CACHE_MAGIC;
+    uint32_t version = PROGRAM_CACHE_VERSION;
+    uint32_t format  = 0;
+    uint32_t length  = 0;
+};
+
+void CHyprOpenGLImpl::initProgramCache() {
+#ifndef GLES2
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if (formats <= 0) {
+        Debug::log(LOG, "Program binary cache: driver exposes no binary formats, disabling");
+        return;
+    }
+
+    const auto  CACHE_HOME = getenv("XDG_CACHE_HOME");
+    const auto  HOME       = getenv("HOME");
+
+    std::string path;
+    if (CACHE_HOME && CACHE_HOME[0] != '\0')
+        path = std::string{CACHE_HOME} + "/hyprland/shaders";
+    else if (HOME && HOME[0] != '\0')
+        path = std::string{HOME} + "/.cache/hyprland/shaders";
+    else {
+        Debug::log(LOG, "Program binary cache: $XDG_CACHE_HOME and $HOME not set, disabling");
+        return;
+    }
+
+    // binaries are only valid for the exact driver that produced them
+    const auto DRIVER = std::format("{}|{}|{}", (const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+    path += std::format("/v{}-{:016x}", PROGRAM_CACHE_VERSION, fnv1a64(DRIVER));
+
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    if (ec) {
+        Debug::log(ERR, "Program binary cache: couldn't create {}: {}", path, ec.message());
+        return;
+    }
+
+    m_sProgramCache.path    = path;
+    m_sProgramCache.enabled = true;
+
+    Debug::log(LOG, "Program binary cache: using {}", path);
+#endif
+}
+
+GLuint CHyprOpenGLImpl::loadCachedProgram(uint64_t hash) {
+#ifndef GLES2
+    const auto    PATH = std::format("{}/{:016x}.bin", m_sProgramCache.path, hash);
+
+    std::ifstream file(PATH, std::ios::binary);
+    if (!file.good())
+        return 0;
+
+    SProgramCacheHeader header;
+    std::error_code     ec;
+    file.read((char*)&header, sizeof(header));
+
+    if (!file.good() || header.magic != PROGRAM_CACHE_MAGIC || header.version != PROGRAM_CACHE_VERSION || header.length == 0) {
+        Debug::log(WARN, "Program binary cache: {} is invalid, removing", PATH);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    file.read(binary.data(), binary.size());
+
+    if (!file.good()) {
+        Debug::log(WARN, "Program binary cache: {} is truncated, removing", PATH);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    auto prog = glCreateProgram();
+    glProgramBinary(prog, header.format, binary.data(), binary.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+
+    if (ok != GL_TRUE) {
+        // usually a driver update, recompile and overwrite
+        Debug::log(LOG, "Program binary cache: driver rejected {}, recompiling", PATH);
+        glDeleteProgram(prog);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    return prog;
+#else
+    return 0;
+#endif
+}
+
+void CHyprOpenGLImpl::storeCachedProgram(uint64_t hash, GLuint program) {
+#ifndef GLES2
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    SProgramCacheHeader header;
+    std::vector<char>   binary(length);
+    GLenum              format = 0;
+
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    if (length <= 0)
+        return;
+
+    header.format = format;
+    header.length = length;
+
+    // write to a temporary and rename, so a crash mid-write never leaves a partial binary behind
+    const auto    PATH    = std::format("{}/{:016x}.bin", m_sProgramCache.path, hash);
+    const auto    TMPPATH = PATH + ".tmp";
+
+    std::ofstream file(TMPPATH, std::ios::binary | std::ios::trunc);
+    file.write((const char*)&header, sizeof(header));
+    file.write(binary.data(), length);
+    file.close();
+
+    std::error_code ec;
+    if (!file.good()) {
+        std::filesystem::remove(TMPPATH, ec);
+        return;
+    }
+
+    std::filesystem::rename(TMPPATH, PATH, ec);
+    if (ec)
+        Debug::log(ERR, "Program binary cache: couldn't write {}: {}", PATH, ec.message());
+#endif
+}
+
 bool CHyprOpenGLImpl::passRequiresIntrospection(PHLMONITOR pMonitor) {
     // passes requiring introspection are the ones that need to render blur,
     // or when we are rendering to a multigpu target
@@ -778,7 +946,7 @@ void CHyprOpenGLImpl::beginSimple(PHLMONITOR pMonitor, const CRegion& damage, SP
 
     m_RenderData.pCurrentMonData = &m_mMonitorRenderResources[pMonitor];
 
-    if (!m_RenderData.pCurrentMonData->m_bShadersInitialized)
+    if (!m_shaders)
         initShaders();
 
     m_RenderData.damage.set(damage);
@@ -829,7 +997,7 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
 
     m_RenderData.pCurrentMonData = &m_mMonitorRenderResources[pMonitor];
 
-    if (!m_RenderData.pCurrentMonData->m_bShadersInitialized)
+    if (!m_shaders)
         initShaders();
 
     // ensure a framebuffer for the monitor exists
@@ -967,171 +1135,167 @@ void CHyprOpenGLImpl::setDamage(const CRegion& damage_, std::optional<CRegion> f
 }
 
 void CHyprOpenGLImpl::initShaders() {
-    GLuint prog                                      = createProgram(QUADVERTSRC, QUADFRAGSRC);
-    m_RenderData.pCurrentMonData->m_shQUAD.program   = prog;
-    m_RenderData.pCurrentMonData->m_shQUAD.proj      = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shQUAD.color     = glGetUniformLocation(prog, "color");
-    m_RenderData.pCurrentMonData->m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shQUAD.topLeft   = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shQUAD.fullSize  = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shQUAD.radius    = glGetUniformLocation(prog, "radius");
-
-    prog                                                     = createProgram(TEXVERTSRC, TEXFRAGSRCRGBA);
-    m_RenderData.pCurrentMonData->m_shRGBA.program           = prog;
-    m_RenderData.pCurrentMonData->m_shRGBA.proj              = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shRGBA.tex               = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shRGBA.alphaMatte        = glGetUniformLocation(prog, "texMatte");
-    m_RenderData.pCurrentMonData->m_shRGBA.alpha             = glGetUniformLocation(prog, "alpha");
-    m_RenderData.pCurrentMonData->m_shRGBA.texAttrib         = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shRGBA.matteTexAttrib    = glGetAttribLocation(prog, "texcoordMatte");
-    m_RenderData.pCurrentMonData->m_shRGBA.posAttrib         = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shRGBA.discardOpaque     = glGetUniformLocation(prog, "discardOpaque");
-    m_RenderData.pCurrentMonData->m_shRGBA.discardAlpha      = glGetUniformLocation(prog, "discardAlpha");
-    m_RenderData.pCurrentMonData->m_shRGBA.discardAlphaValue = glGetUniformLocation(prog, "discardAlphaValue");
-    m_RenderData.pCurrentMonData->m_shRGBA.topLeft           = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shRGBA.fullSize          = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shRGBA.radius            = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shRGBA.applyTint         = glGetUniformLocation(prog, "applyTint");
-    m_RenderData.pCurrentMonData->m_shRGBA.tint              = glGetUniformLocation(prog, "tint");
-    m_RenderData.pCurrentMonData->m_shRGBA.useAlphaMatte     = glGetUniformLocation(prog, "useAlphaMatte");
-
-    prog                                                     = createProgram(TEXVERTSRC, TEXFRAGSRCRGBAPASSTHRU);
-    m_RenderData.pCurrentMonData->m_shPASSTHRURGBA.program   = prog;
-    m_RenderData.pCurrentMonData->m_shPASSTHRURGBA.proj      = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shPASSTHRURGBA.tex       = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shPASSTHRURGBA.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shPASSTHRURGBA.posAttrib = glGetAttribLocation(prog, "pos");
-
-    prog                                               = createProgram(TEXVERTSRC, TEXFRAGSRCRGBAMATTE);
-    m_RenderData.pCurrentMonData->m_shMATTE.program    = prog;
-    m_RenderData.pCurrentMonData->m_shMATTE.proj       = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shMATTE.tex        = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shMATTE.alphaMatte = glGetUniformLocation(prog, "texMatte");
-    m_RenderData.pCurrentMonData->m_shMATTE.texAttrib  = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shMATTE.posAttrib  = glGetAttribLocation(prog, "pos");
-
-    prog                                               = createProgram(TEXVERTSRC, FRAGGLITCH);
-    m_RenderData.pCurrentMonData->m_shGLITCH.program   = prog;
-    m_RenderData.pCurrentMonData->m_shGLITCH.proj      = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shGLITCH.tex       = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shGLITCH.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shGLITCH.posAttrib = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shGLITCH.distort   = glGetUniformLocation(prog, "distort");
-    m_RenderData.pCurrentMonData->m_shGLITCH.time      = glGetUniformLocation(prog, "time");
-    m_RenderData.pCurrentMonData->m_shGLITCH.fullSize  = glGetUniformLocation(prog, "screenSize");
-
-    prog                                                     = createProgram(TEXVERTSRC, TEXFRAGSRCRGBX);
-    m_RenderData.pCurrentMonData->m_shRGBX.program           = prog;
-    m_RenderData.pCurrentMonData->m_shRGBX.tex               = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shRGBX.proj              = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shRGBX.alpha             = glGetUniformLocation(prog, "alpha");
-    m_RenderData.pCurrentMonData->m_shRGBX.texAttrib         = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shRGBX.posAttrib         = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shRGBX.discardOpaque     = glGetUniformLocation(prog, "discardOpaque");
-    m_RenderData.pCurrentMonData->m_shRGBX.discardAlpha      = glGetUniformLocation(prog, "discardAlpha");
-    m_RenderData.pCurrentMonData->m_shRGBX.discardAlphaValue = glGetUniformLocation(prog, "discardAlphaValue");
-    m_RenderData.pCurrentMonData->m_shRGBX.topLeft           = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shRGBX.fullSize          = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shRGBX.radius            = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shRGBX.applyTint         = glGetUniformLocation(prog, "applyTint");
-    m_RenderData.pCurrentMonData->m_shRGBX.tint              = glGetUniformLocation(prog, "tint");
-
-    prog                                                    = createProgram(TEXVERTSRC, TEXFRAGSRCEXT);
-    m_RenderData.pCurrentMonData->m_shEXT.program           = prog;
-    m_RenderData.pCurrentMonData->m_shEXT.tex               = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shEXT.proj              = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shEXT.alpha             = glGetUniformLocation(prog, "alpha");
-    m_RenderData.pCurrentMonData->m_shEXT.posAttrib         = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shEXT.texAttrib         = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shEXT.discardOpaque     = glGetUniformLocation(prog, "discardOpaque");
-    m_RenderData.pCurrentMonData->m_shEXT.discardAlpha      = glGetUniformLocation(prog, "discardAlpha");
-    m_RenderData.pCurrentMonData->m_shEXT.discardAlphaValue = glGetUniformLocation(prog, "discardAlphaValue");
-    m_RenderData.pCurrentMonData->m_shEXT.topLeft           = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shEXT.fullSize          = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shEXT.radius            = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shEXT.applyTint         = glGetUniformLocation(prog, "applyTint");
-    m_RenderData.pCurrentMonData->m_shEXT.tint              = glGetUniformLocation(prog, "tint");
-
-    prog                                                      = createProgram(TEXVERTSRC, FRAGBLUR1);
-    m_RenderData.pCurrentMonData->m_shBLUR1.program           = prog;
-    m_RenderData.pCurrentMonData->m_shBLUR1.tex               = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shBLUR1.alpha             = glGetUniformLocation(prog, "alpha");
-    m_RenderData.pCurrentMonData->m_shBLUR1.proj              = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shBLUR1.posAttrib         = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBLUR1.texAttrib         = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shBLUR1.radius            = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shBLUR1.halfpixel         = glGetUniformLocation(prog, "halfpixel");
-    m_RenderData.pCurrentMonData->m_shBLUR1.passes            = glGetUniformLocation(prog, "passes");
-    m_RenderData.pCurrentMonData->m_shBLUR1.vibrancy          = glGetUniformLocation(prog, "vibrancy");
-    m_RenderData.pCurrentMonData->m_shBLUR1.vibrancy_darkness = glGetUniformLocation(prog, "vibrancy_darkness");
-
-    prog                                              = createProgram(TEXVERTSRC, FRAGBLUR2);
-    m_RenderData.pCurrentMonData->m_shBLUR2.program   = prog;
-    m_RenderData.pCurrentMonData->m_shBLUR2.tex       = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shBLUR2.alpha     = glGetUniformLocation(prog, "alpha");
-    m_RenderData.pCurrentMonData->m_shBLUR2.proj      = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shBLUR2.posAttrib = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBLUR2.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shBLUR2.radius    = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shBLUR2.halfpixel = glGetUniformLocation(prog, "halfpixel");
-
-    prog                                                     = createProgram(TEXVERTSRC, FRAGBLURPREPARE);
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.program    = prog;
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.tex        = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.proj       = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.posAttrib  = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.texAttrib  = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.contrast   = glGetUniformLocation(prog, "contrast");
-    m_RenderData.pCurrentMonData->m_shBLURPREPARE.brightness = glGetUniformLocation(prog, "brightness");
-
-    prog                                                    = createProgram(TEXVERTSRC, FRAGBLURFINISH);
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.program    = prog;
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.tex        = glGetUniformLocation(prog, "tex");
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.proj       = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib  = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib  = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.brightness = glGetUniformLocation(prog, "brightness");
-    m_RenderData.pCurrentMonData->m_shBLURFINISH.noise      = glGetUniformLocation(prog, "noise");
-
-    prog                                                 = createProgram(QUADVERTSRC, FRAGSHADOW);
-    m_RenderData.pCurrentMonData->m_shSHADOW.program     = prog;
-    m_RenderData.pCurrentMonData->m_shSHADOW.proj        = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib   = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib   = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shSHADOW.topLeft     = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shSHADOW.bottomRight = glGetUniformLocation(prog, "bottomRight");
-    m_RenderData.pCurrentMonData->m_shSHADOW.fullSize    = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shSHADOW.radius      = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shSHADOW.range       = glGetUniformLocation(prog, "range");
-    m_RenderData.pCurrentMonData->m_shSHADOW.shadowPower = glGetUniformLocation(prog, "shadowPower");
-    m_RenderData.pCurrentMonData->m_shSHADOW.color       = glGetUniformLocation(prog, "color");
-
-    prog                                                            = createProgram(QUADVERTSRC, FRAGBORDER1);
-    m_RenderData.pCurrentMonData->m_shBORDER1.program               = prog;
-    m_RenderData.pCurrentMonData->m_shBORDER1.proj                  = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shBORDER1.thick                 = glGetUniformLocation(prog, "thick");
-    m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib             = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib             = glGetAttribLocation(prog, "texcoord");
-    m_RenderData.pCurrentMonData->m_shBORDER1.topLeft               = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shBORDER1.bottomRight           = glGetUniformLocation(prog, "bottomRight");
-    m_RenderData.pCurrentMonData->m_shBORDER1.fullSize              = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shBORDER1.fullSizeUntransformed = glGetUniformLocation(prog, "fullSizeUntransformed");
-    m_RenderData.pCurrentMonData->m_shBORDER1.radius                = glGetUniformLocation(prog, "radius");
-    m_RenderData.pCurrentMonData->m_shBORDER1.radiusOuter           = glGetUniformLocation(prog, "radiusOuter");
-    m_RenderData.pCurrentMonData->m_shBORDER1.gradient              = glGetUniformLocation(prog, "gradient");
-    m_RenderData.pCurrentMonData->m_shBORDER1.gradient2             = glGetUniformLocation(prog, "gradient2");
-    m_RenderData.pCurrentMonData->m_shBORDER1.gradientLength        = glGetUniformLocation(prog, "gradientLength");
-    m_RenderData.pCurrentMonData->m_shBORDER1.gradient2Length       = glGetUniformLocation(prog, "gradient2Length");
-    m_RenderData.pCurrentMonData->m_shBORDER1.angle                 = glGetUniformLocation(prog, "angle");
-    m_RenderData.pCurrentMonData->m_shBORDER1.angle2                = glGetUniformLocation(prog, "angle2");
-    m_RenderData.pCurrentMonData->m_shBORDER1.gradientLerp          = glGetUniformLocation(prog, "gradientLerp");
-    m_RenderData.pCurrentMonData->m_shBORDER1.alpha                 = glGetUniformLocation(prog, "alpha");
-
-    m_RenderData.pCurrentMonData->m_bShadersInitialized = true;
+    m_shaders = makeShared<SPreparedShaders>();
+
+    GLuint prog                   = createProgram(QUADVERTSRC, QUADFRAGSRC);
+    m_shaders->m_shQUAD.program   = prog;
+    m_shaders->m_shQUAD.proj      = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shQUAD.color     = glGetUniformLocation(prog, "color");
+    m_shaders->m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shQUAD.topLeft   = glGetUniformLocation(prog, "topLeft");
+    m_shaders->m_shQUAD.fullSize  = glGetUniformLocation(prog, "fullSize");
+    m_shaders->m_shQUAD.radius    = glGetUniformLocation(prog, "radius");
+
+    prog                                  = createProgram(TEXVERTSRC, TEXFRAGSRCRGBAPASSTHRU);
+    m_shaders->m_shPASSTHRURGBA.program   = prog;
+    m_shaders->m_shPASSTHRURGBA.proj      = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shPASSTHRURGBA.tex       = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shPASSTHRURGBA.texAttrib = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shPASSTHRURGBA.posAttrib = glGetAttribLocation(prog, "pos");
+
+    prog                            = createProgram(TEXVERTSRC, TEXFRAGSRCRGBAMATTE);
+    m_shaders->m_shMATTE.program    = prog;
+    m_shaders->m_shMATTE.proj       = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shMATTE.tex        = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shMATTE.alphaMatte = glGetUniformLocation(prog, "texMatte");
+    m_shaders->m_shMATTE.texAttrib  = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shMATTE.posAttrib  = glGetAttribLocation(prog, "pos");
+
+    prog                            = createProgram(TEXVERTSRC, FRAGGLITCH);
+    m_shaders->m_shGLITCH.program   = prog;
+    m_shaders->m_shGLITCH.proj      = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shGLITCH.tex       = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shGLITCH.texAttrib = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shGLITCH.posAttrib = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shGLITCH.distort   = glGetUniformLocation(prog, "distort");
+    m_shaders->m_shGLITCH.time      = glGetUniformLocation(prog, "time");
+    m_shaders->m_shGLITCH.fullSize  = glGetUniformLocation(prog, "screenSize");
+
+    prog                                   = createProgram(TEXVERTSRC, FRAGBLUR1);
+    m_shaders->m_shBLUR1.program           = prog;
+    m_shaders->m_shBLUR1.tex               = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shBLUR1.alpha             = glGetUniformLocation(prog, "alpha");
+    m_shaders->m_shBLUR1.proj              = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shBLUR1.posAttrib         = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shBLUR1.texAttrib         = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shBLUR1.radius            = glGetUniformLocation(prog, "radius");
+    m_shaders->m_shBLUR1.halfpixel         = glGetUniformLocation(prog, "halfpixel");
+    m_shaders->m_shBLUR1.passes            = glGetUniformLocation(prog, "passes");
+    m_shaders->m_shBLUR1.vibrancy          = glGetUniformLocation(prog, "vibrancy");
+    m_shaders->m_shBLUR1.vibrancy_darkness = glGetUniformLocation(prog, "vibrancy_darkness");
+
+    prog                           = createProgram(TEXVERTSRC, FRAGBLUR2);
+    m_shaders->m_shBLUR2.program   = prog;
+    m_shaders->m_shBLUR2.tex       = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shBLUR2.alpha     = glGetUniformLocation(prog, "alpha");
+    m_shaders->m_shBLUR2.proj      = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shBLUR2.posAttrib = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shBLUR2.texAttrib = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shBLUR2.radius    = glGetUniformLocation(prog, "radius");
+    m_shaders->m_shBLUR2.halfpixel = glGetUniformLocation(prog, "halfpixel");
+
+    prog                                  = createProgram(TEXVERTSRC, FRAGBLURPREPARE);
+    m_shaders->m_shBLURPREPARE.program    = prog;
+    m_shaders->m_shBLURPREPARE.tex        = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shBLURPREPARE.proj       = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shBLURPREPARE.posAttrib  = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shBLURPREPARE.texAttrib  = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shBLURPREPARE.contrast   = glGetUniformLocation(prog, "contrast");
+    m_shaders->m_shBLURPREPARE.brightness = glGetUniformLocation(prog, "brightness");
+
+    prog                                 = createProgram(TEXVERTSRC, FRAGBLURFINISH);
+    m_shaders->m_shBLURFINISH.program    = prog;
+    m_shaders->m_shBLURFINISH.tex        = glGetUniformLocation(prog, "tex");
+    m_shaders->m_shBLURFINISH.proj       = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shBLURFINISH.posAttrib  = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shBLURFINISH.texAttrib  = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shBLURFINISH.brightness = glGetUniformLocation(prog, "brightness");
+    m_shaders->m_shBLURFINISH.noise      = glGetUniformLocation(prog, "noise");
+
+    prog                              = createProgram(QUADVERTSRC, FRAGSHADOW);
+    m_shaders->m_shSHADOW.program     = prog;
+    m_shaders->m_shSHADOW.proj        = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shSHADOW.posAttrib   = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shSHADOW.texAttrib   = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shSHADOW.topLeft     = glGetUniformLocation(prog, "topLeft");
+    m_shaders->m_shSHADOW.bottomRight = glGetUniformLocation(prog, "bottomRight");
+    m_shaders->m_shSHADOW.fullSize    = glGetUniformLocation(prog, "fullSize");
+    m_shaders->m_shSHADOW.radius      = glGetUniformLocation(prog, "radius");
+    m_shaders->m_shSHADOW.range       = glGetUniformLocation(prog, "range");
+    m_shaders->m_shSHADOW.shadowPower = glGetUniformLocation(prog, "shadowPower");
+    m_shaders->m_shSHADOW.color       = glGetUniformLocation(prog, "color");
+
+    prog                                         = createProgram(QUADVERTSRC, FRAGBORDER1);
+    m_shaders->m_shBORDER1.program               = prog;
+    m_shaders->m_shBORDER1.proj                  = glGetUniformLocation(prog, "proj");
+    m_shaders->m_shBORDER1.thick                 = glGetUniformLocation(prog, "thick");
+    m_shaders->m_shBORDER1.posAttrib             = glGetAttribLocation(prog, "pos");
+    m_shaders->m_shBORDER1.texAttrib             = glGetAttribLocation(prog, "texcoord");
+    m_shaders->m_shBORDER1.topLeft               = glGetUniformLocation(prog, "topLeft");
+    m_shaders->m_shBORDER1.bottomRight           = glGetUniformLocation(prog, "bottomRight");
+    m_shaders->m_shBORDER1.fullSize              = glGetUniformLocation(prog, "fullSize");
+    m_shaders->m_shBORDER1.fullSizeUntransformed = glGetUniformLocation(prog, "fullSizeUntransformed");
+    m_shaders->m_shBORDER1.radius                = glGetUniformLocation(prog, "radius");
+    m_shaders->m_shBORDER1.radiusOuter           = glGetUniformLocation(prog, "radiusOuter");
+    m_shaders->m_shBORDER1.gradient              = glGetUniformLocation(prog, "gradient");
+    m_shaders->m_shBORDER1.gradient2             = glGetUniformLocation(prog, "gradient2");
+    m_shaders->m_shBORDER1.gradientLength        = glGetUniformLocation(prog, "gradientLength");
+    m_shaders->m_shBORDER1.gradient2Length       = glGetUniformLocation(prog, "gradient2Length");
+    m_shaders->m_shBORDER1.angle                 = glGetUniformLocation(prog, "angle");
+    m_shaders->m_shBORDER1.angle2                = glGetUniformLocation(prog, "angle2");
+    m_shaders->m_shBORDER1.gradientLerp          = glGetUniformLocation(prog, "gradientLerp");
+    m_shaders->m_shBORDER1.alpha                 = glGetUniformLocation(prog, "alpha");
 
     Debug::log(LOG, "Shaders initialized successfully.");
 }
 
+CShader* CHyprOpenGLImpl::getTextureShader(eTextureType type, uint8_t features) {
+    // only the RGBA shader can discard on alpha, RGBX is opaque and EXT doesn't support it
+    if (type != TEXTURE_RGBA)
+        features &= ~SH_FEAT_DISCARD_ALPHA;
+
+    auto& shader = m_shaders->m_vTextureShaders.at(type * (SH_FEAT_ALL + 1) + features);
+    if (shader)
+        return shader.get();
+
+    std::string defines;
+    if (features & SH_FEAT_DISCARD_OPAQUE)
+        defines += "#define DISCARD_OPAQUE\n";
+    if (features & SH_FEAT_DISCARD_ALPHA)
+        defines += "#define DISCARD_ALPHA\n";
+    if (features & SH_FEAT_TINT)
+        defines += "#define TINT\n";
+    if (features & SH_FEAT_ROUNDING)
+        defines += "#define ROUNDING\n";
+
+    std::string frag;
+    switch (type) {
+        case TEXTURE_RGBA: frag = defines + TEXFRAGSRCRGBA; break;
+        case TEXTURE_RGBX: frag = defines + TEXFRAGSRCRGBX; break;
+        case TEXTURE_EXTERNAL: frag = defines + TEXFRAGSRCEXT; break;
+        default: RASSERT(false, "getTextureShader: unsupported texture type {}", (int)type);
+    }
+
+    shader = std::make_unique<CShader>();
+
+    GLuint prog               = createProgram(TEXVERTSRC, frag);
+    shader->program           = prog;
+    shader->proj              = glGetUniformLocation(prog, "proj");
+    shader->tex               = glGetUniformLocation(prog, type == TEXTURE_EXTERNAL ? "texture0" : "tex");
+    shader->alpha             = glGetUniformLocation(prog, "alpha");
+    shader->texAttrib         = glGetAttribLocation(prog, "texcoord");
+    shader->posAttrib         = glGetAttribLocation(prog, "pos");
+    shader->discardAlphaValue = glGetUniformLocation(prog, "discardAlphaValue");
+    shader->topLeft           = glGetUniformLocation(prog, "topLeft");
+    shader->fullSize          = glGetUniformLocation(prog, "fullSize");
+    shader->radius            = glGetUniformLocation(prog, "radius");
+    shader->tint              = glGetUniformLocation(prog, "tint");
+
+    Debug::log(LOG, "Compiled texture shader variant {} for type {}", features, (int)type);
+
+    return shader.get();
+}
+
 void CHyprOpenGLImpl::applyScreenShader(const std::string& path) {
 
     static auto PDT = CConfigValue<Hyprlang::INT>("debug:damage_tracking");
@@ -1203,6 +1367,59 @@ void CHyprOpenGLImpl::blend(bool enabled) {
     m_bBlend = enabled;
 }
 
+void CHyprOpenGLImpl::drawQuad() {
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_sStats.drawCalls++;
+}
+
+// Draws the bound program's unit quad over box, limited to damage (and the clip box), with one draw call.
+// Instead of scissoring to each damage rect in turn, the quad is cut into one piece per rect.
+void CHyprOpenGLImpl::drawQuadWithDamage(const CBox& box, const CRegion& damage, GLint posAttrib, GLint texAttrib) {
+    CRegion clipped{damage};
+
+    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0)
+        clipped.intersect(m_RenderData.clipBox);
+
+    if (clipped.empty())
+        return;
+
+    // pieces of a rotated or transformed quad aren't axis-aligned in box space
+    if (box.rot != 0 || m_bEndFrame) {
+        for (auto const& RECT : clipped.getRects()) {
+            scissor(&RECT);
+            drawQuad();
+        }
+
+        return;
+    }
+
+    m_vDamageQuadVerts.clear();
+
+    for (auto const& RECT : clipped.getRects()) {
+        const float X1 = (std::max<double>(RECT.x1, box.x) - box.x) / box.width;
+        const float Y1 = (std::max<double>(RECT.y1, box.y) - box.y) / box.height;
+        const float X2 = (std::min<double>(RECT.x2, box.x + box.width) - box.x) / box.width;
+        const float Y2 = (std::min<double>(RECT.y2, box.y + box.height) - box.y) / box.height;
+
+        if (X2 <= X1 || Y2 <= Y1)
+            continue;
+
+        m_vDamageQuadVerts.insert(m_vDamageQuadVerts.end(), {X1, Y1, X2, Y1, X1, Y2, X2, Y1, X2, Y2, X1, Y2});
+    }
+
+    if (m_vDamageQuadVerts.empty())
+        return;
+
+    scissor((CBox*)nullptr);
+
+    glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 0, m_vDamageQuadVerts.data());
+    if (texAttrib != -1)
+        glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, 0, m_vDamageQuadVerts.data());
+
+    glDrawArrays(GL_TRIANGLES, 0, m_vDamageQuadVerts.size() / 2);
+    m_sStats.drawCalls++;
+}
+
 void CHyprOpenGLImpl::scissor(const CBox* pBox, bool transform) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
@@ -1307,17 +1524,17 @@ void CHyprOpenGLImpl::renderRectWithDamage(CBox* box, const CHyprColor& col, CRe
         newBox, wlTransformToHyprutils(invertTransform(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform)), newBox.rot);
     Mat3x3 glMatrix = m_RenderData.projection.copy().multiply(matrix);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shQUAD.program);
+    glUseProgram(m_shaders->m_shQUAD.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shQUAD.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shQUAD.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shQUAD.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shQUAD.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
     // premultiply the color as well as we don't work with straight alpha
-    glUniform4f(m_RenderData.pCurrentMonData->m_shQUAD.color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
+    glUniform4f(m_shaders->m_shQUAD.color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
 
     CBox transformedBox = *box;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -1327,32 +1544,17 @@ void CHyprOpenGLImpl::renderRectWithDamage(CBox* box, const CHyprColor& col, CRe
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
     // Rounded corners
-    glUniform2f(m_RenderData.pCurrentMonData->m_shQUAD.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shQUAD.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shQUAD.radius, round);
+    glUniform2f(m_shaders->m_shQUAD.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    glUniform2f(m_shaders->m_shQUAD.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    glUniform1f(m_shaders->m_shQUAD.radius, round);
 
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shQUAD.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shQUAD.posAttrib);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(*damage);
+    drawQuadWithDamage(newBox, *damage, m_shaders->m_shQUAD.posAttrib);
 
-        if (!damageClip.empty()) {
-            for (auto const& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto const& RECT : damage->getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
-
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shQUAD.posAttrib);
 
     scissor((CBox*)nullptr);
 }
@@ -1413,28 +1615,38 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, CBox* pB
 
     const bool CRASHING = m_bApplyFinalShader && g_pHyprRenderer->m_bCrashingInProgress;
 
+    uint8_t    shaderFeatures = 0;
+    if (discardActive && (m_RenderData.discardMode & DISCARD_OPAQUE))
+        shaderFeatures |= SH_FEAT_DISCARD_OPAQUE;
+    if (discardActive && (m_RenderData.discardMode & DISCARD_ALPHA))
+        shaderFeatures |= SH_FEAT_DISCARD_ALPHA;
+    if ((allowDim && m_pCurrentWindow.lock()) || m_RenderData.textureTint)
+        shaderFeatures |= SH_FEAT_TINT;
+    if (round > 0)
+        shaderFeatures |= SH_FEAT_ROUNDING;
+
     if (CRASHING) {
-        shader           = &m_RenderData.pCurrentMonData->m_shGLITCH;
+        shader           = &m_shaders->m_shGLITCH;
         usingFinalShader = true;
     } else if (m_bApplyFinalShader && m_sFinalScreenShader.program) {
         shader           = &m_sFinalScreenShader;
         usingFinalShader = true;
     } else {
         if (m_bApplyFinalShader) {
-            shader           = &m_RenderData.pCurrentMonData->m_shPASSTHRURGBA;
+            shader           = &m_shaders->m_shPASSTHRURGBA;
             usingFinalShader = true;
         } else {
             switch (tex->m_iType) {
-                case TEXTURE_RGBA: shader = &m_RenderData.pCurrentMonData->m_shRGBA; break;
-                case TEXTURE_RGBX: shader = &m_RenderData.pCurrentMonData->m_shRGBX; break;
-                case TEXTURE_EXTERNAL: shader = &m_RenderData.pCurrentMonData->m_shEXT; break;
+                case TEXTURE_RGBA:
+                case TEXTURE_RGBX:
+                case TEXTURE_EXTERNAL: shader = getTextureShader(tex->m_iType, shaderFeatures); break;
                 default: RASSERT(false, "tex->m_iTarget unsupported!");
             }
         }
     }
 
     if (m_pCurrentWindow.lock() && m_pCurrentWindow->m_sWindowData.RGBX.valueOrDefault())
-        shader = &m_RenderData.pCurrentMonData->m_shRGBX;
+        shader = getTextureShader(TEXTURE_RGBX, shaderFeatures);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(tex->m_iTarget, tex->m_iTexID);
@@ -1480,14 +1692,8 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, CBox* pB
     if (!usingFinalShader) {
         glUniform1f(shader->alpha, alpha);
 
-        if (discardActive) {
-            glUniform1i(shader->discardOpaque, !!(m_RenderData.discardMode & DISCARD_OPAQUE));
-            glUniform1i(shader->discardAlpha, !!(m_RenderData.discardMode & DISCARD_ALPHA));
+        if (shaderFeatures & SH_FEAT_DISCARD_ALPHA)
             glUniform1f(shader->discardAlphaValue, m_RenderData.discardOpacity);
-        } else {
-            glUniform1i(shader->discardOpaque, 0);
-            glUniform1i(shader->discardAlpha, 0);
-        }
     }
 
     CBox transformedBox = newBox;
@@ -1499,16 +1705,19 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, CBox* pB
 
     if (!usingFinalShader) {
         // Rounded corners
-        glUniform2f(shader->topLeft, TOPLEFT.x, TOPLEFT.y);
-        glUniform2f(shader->fullSize, FULLSIZE.x, FULLSIZE.y);
-        glUniform1f(shader->radius, round);
-
-        if (allowDim && m_pCurrentWindow.lock()) {
-            glUniform1i(shader->applyTint, 1);
-            const auto DIM = m_pCurrentWindow->m_fDimPercent.value();
-            glUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
-        } else {
-            glUniform1i(shader->applyTint, 0);
+        if (shaderFeatures & SH_FEAT_ROUNDING) {
+            glUniform2f(shader->topLeft, TOPLEFT.x, TOPLEFT.y);
+            glUniform2f(shader->fullSize, FULLSIZE.x, FULLSIZE.y);
+            glUniform1f(shader->radius, round);
+        }
+
+        if (shaderFeatures & SH_FEAT_TINT) {
+            if (m_RenderData.textureTint)
+                glUniform3f(shader->tint, m_RenderData.textureTint->r, m_RenderData.textureTint->g, m_RenderData.textureTint->b);
+            else {
+                const auto DIM = m_pCurrentWindow->m_fDimPercent.value();
+                glUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
+            }
         }
     }
 
@@ -1537,13 +1746,13 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, CBox* pB
         if (!damageClip.empty()) {
             for (auto const& RECT : damageClip.getRects()) {
                 scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                drawQuad();
             }
         }
     } else {
         for (auto const& RECT : damage->getRects()) {
             scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            drawQuad();
         }
     }
 
@@ -1570,7 +1779,7 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, CBox* pBox) {
     Mat3x3     matrix    = m_RenderData.monitorProjection.projectBox(newBox, TRANSFORM, newBox.rot);
     Mat3x3     glMatrix  = m_RenderData.projection.copy().multiply(matrix);
 
-    CShader*   shader = &m_RenderData.pCurrentMonData->m_shPASSTHRURGBA;
+    CShader*   shader = &m_shaders->m_shPASSTHRURGBA;
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(tex->m_iTarget, tex->m_iTexID);
@@ -1593,7 +1802,7 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, CBox* pBox) {
 
     for (auto const& RECT : m_RenderData.damage.getRects()) {
         scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        drawQuad();
     }
 
     scissor((CBox*)nullptr);
@@ -1621,7 +1830,7 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, CBox* pBox, CFramebuf
     Mat3x3     matrix    = m_RenderData.monitorProjection.projectBox(newBox, TRANSFORM, newBox.rot);
     Mat3x3     glMatrix  = m_RenderData.projection.copy().multiply(matrix);
 
-    CShader*   shader = &m_RenderData.pCurrentMonData->m_shMATTE;
+    CShader*   shader = &m_shaders->m_shMATTE;
 
     glUseProgram(shader->program);
 
@@ -1649,7 +1858,7 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, CBox* pBox, CFramebuf
 
     for (auto const& RECT : m_RenderData.damage.getRects()) {
         scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        drawQuad();
     }
 
     scissor((CBox*)nullptr);
@@ -1688,12 +1897,13 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     static auto PBLURPASSES           = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
     static auto PBLURVIBRANCY         = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy");
     static auto PBLURVIBRANCYDARKNESS = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy_darkness");
+    static auto PBLURRADIUS           = CDerivedConfigValue<double>([] { return g_pHyprOpenGL->getBlurRadius(); });
 
     // prep damage
     CRegion damage{*originalDamage};
     damage.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
                      m_RenderData.pMonitor->vecTransformedSize.y);
-    damage.expand(*PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES));
+    damage.expand(*PBLURRADIUS);
 
     // helper
     const auto    PMIRRORFB     = &m_RenderData.pCurrentMonData->mirrorFB;
@@ -1717,33 +1927,33 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         glTexParameteri(currentTex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_RenderData.pCurrentMonData->m_shBLURPREPARE.program);
+        glUseProgram(m_shaders->m_shBLURPREPARE.program);
 
 #ifndef GLES2
-        glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURPREPARE.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+        glUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
         glMatrix.transpose();
-        glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURPREPARE.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+        glUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-        glUniform1f(m_RenderData.pCurrentMonData->m_shBLURPREPARE.contrast, *PBLURCONTRAST);
-        glUniform1f(m_RenderData.pCurrentMonData->m_shBLURPREPARE.brightness, *PBLURBRIGHTNESS);
-        glUniform1i(m_RenderData.pCurrentMonData->m_shBLURPREPARE.tex, 0);
+        glUniform1f(m_shaders->m_shBLURPREPARE.contrast, *PBLURCONTRAST);
+        glUniform1f(m_shaders->m_shBLURPREPARE.brightness, *PBLURBRIGHTNESS);
+        glUniform1i(m_shaders->m_shBLURPREPARE.tex, 0);
 
-        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURPREPARE.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURPREPARE.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+        glVertexAttribPointer(m_shaders->m_shBLURPREPARE.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+        glVertexAttribPointer(m_shaders->m_shBLURPREPARE.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-        glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURPREPARE.posAttrib);
-        glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURPREPARE.texAttrib);
+        glEnableVertexAttribArray(m_shaders->m_shBLURPREPARE.posAttrib);
+        glEnableVertexAttribArray(m_shaders->m_shBLURPREPARE.texAttrib);
 
         if (!damage.empty()) {
             for (auto const& RECT : damage.getRects()) {
                 scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                drawQuad();
             }
         }
 
-        glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURPREPARE.posAttrib);
-        glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURPREPARE.texAttrib);
+        glDisableVertexAttribArray(m_shaders->m_shBLURPREPARE.posAttrib);
+        glDisableVertexAttribArray(m_shaders->m_shBLURPREPARE.texAttrib);
 
         currentRenderToFB = PMIRRORSWAPFB;
     }
@@ -1773,14 +1983,14 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         glUniformMatrix3fv(pShader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
         glUniform1f(pShader->radius, *PBLURSIZE * a); // this makes the blursize change with a
-        if (pShader == &m_RenderData.pCurrentMonData->m_shBLUR1) {
-            glUniform2f(m_RenderData.pCurrentMonData->m_shBLUR1.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f),
+        if (pShader == &m_shaders->m_shBLUR1) {
+            glUniform2f(m_shaders->m_shBLUR1.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f),
                         0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
-            glUniform1i(m_RenderData.pCurrentMonData->m_shBLUR1.passes, *PBLURPASSES);
-            glUniform1f(m_RenderData.pCurrentMonData->m_shBLUR1.vibrancy, *PBLURVIBRANCY);
-            glUniform1f(m_RenderData.pCurrentMonData->m_shBLUR1.vibrancy_darkness, *PBLURVIBRANCYDARKNESS);
+            glUniform1i(m_shaders->m_shBLUR1.passes, *PBLURPASSES);
+            glUniform1f(m_shaders->m_shBLUR1.vibrancy, *PBLURVIBRANCY);
+            glUniform1f(m_shaders->m_shBLUR1.vibrancy_darkness, *PBLURVIBRANCYDARKNESS);
         } else
-            glUniform2f(m_RenderData.pCurrentMonData->m_shBLUR2.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f),
+            glUniform2f(m_shaders->m_shBLUR2.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f),
                         0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
         glUniform1i(pShader->tex, 0);
 
@@ -1793,7 +2003,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         if (!pDamage->empty()) {
             for (auto const& RECT : pDamage->getRects()) {
                 scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                drawQuad();
             }
         }
 
@@ -1817,12 +2027,12 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     // and draw
     for (auto i = 1; i <= *PBLURPASSES; ++i) {
         tempDamage = damage.copy().scale(1.f / (1 << i));
-        drawPass(&m_RenderData.pCurrentMonData->m_shBLUR1, &tempDamage); // down
+        drawPass(&m_shaders->m_shBLUR1, &tempDamage); // down
     }
 
     for (auto i = *PBLURPASSES - 1; i >= 0; --i) {
         tempDamage = damage.copy().scale(1.f / (1 << i));                // when upsampling we make the region twice as big
-        drawPass(&m_RenderData.pCurrentMonData->m_shBLUR2, &tempDamage); // up
+        drawPass(&m_shaders->m_shBLUR2, &tempDamage); // up
     }
 
     // finalize the image
@@ -1843,34 +2053,34 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         glTexParameteri(currentTex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_RenderData.pCurrentMonData->m_shBLURFINISH.program);
+        glUseProgram(m_shaders->m_shBLURFINISH.program);
 
 #ifndef GLES2
-        glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURFINISH.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+        glUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
         glMatrix.transpose();
-        glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURFINISH.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+        glUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-        glUniform1f(m_RenderData.pCurrentMonData->m_shBLURFINISH.noise, *PBLURNOISE);
-        glUniform1f(m_RenderData.pCurrentMonData->m_shBLURFINISH.brightness, *PBLURBRIGHTNESS);
+        glUniform1f(m_shaders->m_shBLURFINISH.noise, *PBLURNOISE);
+        glUniform1f(m_shaders->m_shBLURFINISH.brightness, *PBLURBRIGHTNESS);
 
-        glUniform1i(m_RenderData.pCurrentMonData->m_shBLURFINISH.tex, 0);
+        glUniform1i(m_shaders->m_shBLURFINISH.tex, 0);
 
-        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+        glVertexAttribPointer(m_shaders->m_shBLURFINISH.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+        glVertexAttribPointer(m_shaders->m_shBLURFINISH.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-        glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib);
-        glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib);
+        glEnableVertexAttribArray(m_shaders->m_shBLURFINISH.posAttrib);
+        glEnableVertexAttribArray(m_shaders->m_shBLURFINISH.texAttrib);
 
         if (!damage.empty()) {
             for (auto const& RECT : damage.getRects()) {
                 scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                drawQuad();
             }
         }
 
-        glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib);
-        glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib);
+        glDisableVertexAttribArray(m_shaders->m_shBLURFINISH.posAttrib);
+        glDisableVertexAttribArray(m_shaders->m_shBLURFINISH.texAttrib);
 
         if (currentRenderToFB != PMIRRORFB)
             currentRenderToFB = PMIRRORFB;
@@ -1886,6 +2096,13 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     return currentRenderToFB;
 }
 
+double CHyprOpenGLImpl::getBlurRadius() {
+    static auto PBLURSIZE   = CConfigValue<Hyprlang::INT>("decoration:blur:size");
+    static auto PBLURPASSES = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
+
+    return *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES); // is this 2^pass? I don't know but it works... I think.
+}
+
 void CHyprOpenGLImpl::markBlurDirtyForMonitor(PHLMONITOR pMonitor) {
     m_mMonitorRenderResources[pMonitor].blurFBDirty = true;
 }
@@ -2184,20 +2401,20 @@ void CHyprOpenGLImpl::renderBorder(CBox* box, const CGradientValueData& grad, in
     const auto BLEND = m_bBlend;
     blend(true);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shBORDER1.program);
+    glUseProgram(m_shaders->m_shBORDER1.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
-    glUniform4fv(m_RenderData.pCurrentMonData->m_shBORDER1.gradient, grad.m_vColorsOkLabA.size(), (float*)grad.m_vColorsOkLabA.data());
-    glUniform1i(m_RenderData.pCurrentMonData->m_shBORDER1.gradientLength, grad.m_vColorsOkLabA.size() / 4);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.angle, (int)(grad.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.alpha, a);
-    glUniform1i(m_RenderData.pCurrentMonData->m_shBORDER1.gradient2Length, 0);
+    glUniform4fv(m_shaders->m_shBORDER1.gradient, grad.m_vColorsOkLabA.size(), (float*)grad.m_vColorsOkLabA.data());
+    glUniform1i(m_shaders->m_shBORDER1.gradientLength, grad.m_vColorsOkLabA.size() / 4);
+    glUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
+    glUniform1f(m_shaders->m_shBORDER1.alpha, a);
+    glUniform1i(m_shaders->m_shBORDER1.gradient2Length, 0);
 
     CBox transformedBox = *box;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -2206,38 +2423,23 @@ void CHyprOpenGLImpl::renderBorder(CBox* box, const CGradientValueData& grad, in
     const auto TOPLEFT  = Vector2D(transformedBox.x, transformedBox.y);
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.fullSizeUntransformed, (float)box->width, (float)box->height);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.radius, round);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.thick, scaledBorderSize);
+    glUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    glUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    glUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)box->width, (float)box->height);
+    glUniform1f(m_shaders->m_shBORDER1.radius, round);
+    glUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
+    glUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
 
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shBORDER1.posAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shBORDER1.texAttrib);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(m_RenderData.damage);
+    drawQuadWithDamage(newBox, m_RenderData.damage, m_shaders->m_shBORDER1.posAttrib, m_shaders->m_shBORDER1.texAttrib);
 
-        if (!damageClip.empty()) {
-            for (auto const& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto const& RECT : m_RenderData.damage.getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
-
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shBORDER1.posAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shBORDER1.texAttrib);
 
     blend(BLEND);
 }
@@ -2277,23 +2479,23 @@ void CHyprOpenGLImpl::renderBorder(CBox* box, const CGradientValueData& grad1, c
     const auto BLEND = m_bBlend;
     blend(true);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shBORDER1.program);
+    glUseProgram(m_shaders->m_shBORDER1.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
-    glUniform4fv(m_RenderData.pCurrentMonData->m_shBORDER1.gradient, grad1.m_vColorsOkLabA.size(), (float*)grad1.m_vColorsOkLabA.data());
-    glUniform1i(m_RenderData.pCurrentMonData->m_shBORDER1.gradientLength, grad1.m_vColorsOkLabA.size() / 4);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.angle, (int)(grad1.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
-    glUniform4fv(m_RenderData.pCurrentMonData->m_shBORDER1.gradient2, grad2.m_vColorsOkLabA.size(), (float*)grad2.m_vColorsOkLabA.data());
-    glUniform1i(m_RenderData.pCurrentMonData->m_shBORDER1.gradient2Length, grad2.m_vColorsOkLabA.size() / 4);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.angle2, (int)(grad2.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.alpha, a);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.gradientLerp, lerp);
+    glUniform4fv(m_shaders->m_shBORDER1.gradient, grad1.m_vColorsOkLabA.size(), (float*)grad1.m_vColorsOkLabA.data());
+    glUniform1i(m_shaders->m_shBORDER1.gradientLength, grad1.m_vColorsOkLabA.size() / 4);
+    glUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad1.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
+    glUniform4fv(m_shaders->m_shBORDER1.gradient2, grad2.m_vColorsOkLabA.size(), (float*)grad2.m_vColorsOkLabA.data());
+    glUniform1i(m_shaders->m_shBORDER1.gradient2Length, grad2.m_vColorsOkLabA.size() / 4);
+    glUniform1f(m_shaders->m_shBORDER1.angle2, (int)(grad2.m_fAngle / (PI / 180.0)) % 360 * (PI / 180.0));
+    glUniform1f(m_shaders->m_shBORDER1.alpha, a);
+    glUniform1f(m_shaders->m_shBORDER1.gradientLerp, lerp);
 
     CBox transformedBox = *box;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -2302,38 +2504,23 @@ void CHyprOpenGLImpl::renderBorder(CBox* box, const CGradientValueData& grad1, c
     const auto TOPLEFT  = Vector2D(transformedBox.x, transformedBox.y);
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shBORDER1.fullSizeUntransformed, (float)box->width, (float)box->height);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.radius, round);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.thick, scaledBorderSize);
-
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    glUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    glUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)box->width, (float)box->height);
+    glUniform1f(m_shaders->m_shBORDER1.radius, round);
+    glUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
+    glUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
 
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
+    glVertexAttribPointer(m_shaders->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(m_RenderData.damage);
+    glEnableVertexAttribArray(m_shaders->m_shBORDER1.posAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shBORDER1.texAttrib);
 
-        if (!damageClip.empty()) {
-            for (auto const& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto const& RECT : m_RenderData.damage.getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
+    drawQuadWithDamage(newBox, m_RenderData.damage, m_shaders->m_shBORDER1.posAttrib, m_shaders->m_shBORDER1.texAttrib);
 
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shBORDER1.posAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shBORDER1.texAttrib);
 
     blend(BLEND);
 }
@@ -2477,6 +2664,79 @@ void CHyprOpenGLImpl::makeLayerSnapshot(PHLLS pLayer) {
     g_pHyprRenderer->m_bRenderingSnapshot = false;
 }
 
+void CHyprOpenGLImpl::makeWorkspaceSnapshot(PHLWORKSPACE pWorkspace) {
+    const auto PMONITOR = pWorkspace->m_pMonitor.lock();
+
+    if (!PMONITOR || !PMONITOR->output || PMONITOR->vecPixelSize.x <= 0 || PMONITOR->vecPixelSize.y <= 0)
+        return;
+
+    CRegion fakeDamage{0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y};
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    auto& snapshot = m_mWorkspaceSnapshots[pWorkspace];
+
+    snapshot.fb.alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->output->state->state().drmFormat);
+    snapshot.dirty = false;
+    m_sStats.workspaceSnapshots++;
+
+    g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &snapshot.fb);
+
+    g_pHyprRenderer->m_bRenderingSnapshot = true;
+
+    clear(CHyprColor(0, 0, 0, 0)); // JIC
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // same as window snapshots, blur would only see the empty framebuffer
+    static auto* const PBLUR   = (Hyprlang::INT* const*)(g_pConfigManager->getConfigValuePtr("decoration:blur:enabled"));
+    const auto         BLURVAL = **PBLUR;
+    **PBLUR                    = 0;
+
+    // undo the slide, the current offset is applied when the snapshot is drawn
+    m_RenderData.renderModif = {};
+    m_RenderData.renderModif.add(SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, pWorkspace->m_vRenderOffset.value() * -PMONITOR->scale);
+
+    // same order as renderWorkspaceWindows. Decorations are drawn live around the snapshot, see CHyprRenderer::renderWorkspaceSnapshot
+    for (const bool FLOATING : {false, true}) {
+        PHLWINDOW lastWindow;
+
+        for (auto const& w : g_pCompositor->m_vWindows) {
+            if (!g_pHyprRenderer->isInWorkspaceSnapshot(w) || w->m_pWorkspace != pWorkspace || w->m_bIsFloating != FLOATING)
+                continue;
+
+            if (!FLOATING && w == g_pCompositor->m_pLastWindow) {
+                lastWindow = w;
+                continue;
+            }
+
+            g_pHyprRenderer->renderWindow(w, PMONITOR, &now, false, FLOATING ? RENDER_PASS_ALL : RENDER_PASS_MAIN);
+        }
+
+        if (lastWindow)
+            g_pHyprRenderer->renderWindow(lastWindow, PMONITOR, &now, false, RENDER_PASS_MAIN);
+
+        if (FLOATING)
+            continue;
+
+        for (auto const& w : g_pCompositor->m_vWindows) {
+            if (!g_pHyprRenderer->isInWorkspaceSnapshot(w) || w->m_pWorkspace != pWorkspace || w->m_bIsFloating)
+                continue;
+
+            g_pHyprRenderer->renderWindow(w, PMONITOR, &now, false, RENDER_PASS_POPUP);
+        }
+    }
+
+    m_RenderData.renderModif = {};
+
+    **PBLUR = BLURVAL;
+
+    g_pHyprRenderer->endRender();
+
+    g_pHyprRenderer->m_bRenderingSnapshot = false;
+}
+
 void CHyprOpenGLImpl::renderSnapshot(PHLWINDOW pWindow) {
     RASSERT(m_RenderData.pMonitor, "Tried to render snapshot rect without begin()!");
 
@@ -2553,6 +2813,25 @@ void CHyprOpenGLImpl::renderSnapshot(PHLLS pLayer) {
     m_bEndFrame = false;
 }
 
+void CHyprOpenGLImpl::renderSnapshot(PHLWORKSPACE pWorkspace) {
+    RASSERT(m_RenderData.pMonitor, "Tried to render snapshot rect without begin()!");
+
+    const auto IT = m_mWorkspaceSnapshots.find(pWorkspace);
+
+    if (IT == m_mWorkspaceSnapshots.end() || !IT->second.fb.getTexture())
+        return;
+
+    const auto PMONITOR = m_RenderData.pMonitor.lock();
+
+    CBox       workspaceBox = {pWorkspace->m_vRenderOffset.value() * PMONITOR->scale, PMONITOR->vecTransformedSize};
+
+    m_bEndFrame = true;
+
+    renderTextureInternalWithDamage(IT->second.fb.getTexture(), &workspaceBox, 1.F, &m_RenderData.damage, 0);
+
+    m_bEndFrame = false;
+}
+
 void CHyprOpenGLImpl::renderRoundedShadow(CBox* box, int round, int range, const CHyprColor& color, float a) {
     RASSERT(m_RenderData.pMonitor, "Tried to render shadow without begin()!");
     RASSERT((box->width > 0 && box->height > 0), "Tried to render shadow with width/height < 0!");
@@ -2580,53 +2859,38 @@ void CHyprOpenGLImpl::renderRoundedShadow(CBox* box, int round, int range, const
 
     blend(true);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shSHADOW.program);
+    glUseProgram(m_shaders->m_shSHADOW.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shSHADOW.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shSHADOW.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    glUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-    glUniform4f(m_RenderData.pCurrentMonData->m_shSHADOW.color, col.r, col.g, col.b, col.a * a);
+    glUniform4f(m_shaders->m_shSHADOW.color, col.r, col.g, col.b, col.a * a);
 
     const auto TOPLEFT     = Vector2D(range + round, range + round);
     const auto BOTTOMRIGHT = Vector2D(box->width - (range + round), box->height - (range + round));
     const auto FULLSIZE    = Vector2D(box->width, box->height);
 
     // Rounded corners
-    glUniform2f(m_RenderData.pCurrentMonData->m_shSHADOW.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shSHADOW.bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(m_RenderData.pCurrentMonData->m_shSHADOW.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shSHADOW.radius, range + round);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shSHADOW.range, range);
-    glUniform1f(m_RenderData.pCurrentMonData->m_shSHADOW.shadowPower, SHADOWPOWER);
+    glUniform2f(m_shaders->m_shSHADOW.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    glUniform2f(m_shaders->m_shSHADOW.bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
+    glUniform2f(m_shaders->m_shSHADOW.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    glUniform1f(m_shaders->m_shSHADOW.radius, range + round);
+    glUniform1f(m_shaders->m_shSHADOW.range, range);
+    glUniform1f(m_shaders->m_shSHADOW.shadowPower, SHADOWPOWER);
 
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shSHADOW.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glVertexAttribPointer(m_shaders->m_shSHADOW.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib);
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shSHADOW.posAttrib);
+    glEnableVertexAttribArray(m_shaders->m_shSHADOW.texAttrib);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(m_RenderData.damage);
-
-        if (!damageClip.empty()) {
-            for (auto const& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto const& RECT : m_RenderData.damage.getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
+    drawQuadWithDamage(newBox, m_RenderData.damage, m_shaders->m_shSHADOW.posAttrib, m_shaders->m_shSHADOW.texAttrib);
 
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib);
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shSHADOW.posAttrib);
+    glDisableVertexAttribArray(m_shaders->m_shSHADOW.texAttrib);
 }
 
 void CHyprOpenGLImpl::saveBufferForMirror(CBox* box) {
@@ -3175,65 +3439,174 @@ bool CHyprOpenGLImpl::waitForTimelinePoint(SP<CSyncTimeline> timeline, uint64_t
     return true;
 }
 
-void SRenderModifData::applyToBox(CBox& box) {
-    if (!enabled)
-        return;
+bool CHyprOpenGLImpl::uploadThroughStaging(const SPixelFormat* format, const uint8_t* pixels, uint32_t stride, const std::vector<pixman_box32_t>& rects) {
+#ifdef GLES2
+    return false;
+#else
+    // below this, the synchronous copy is cheaper than mapping a buffer
+    constexpr size_t MIN_STAGED_BYTES = 64 * 1024;
+    constexpr size_t MAX_STAGED_BYTES = 64 * 1024 * 1024;
+
+    // rows are packed at GL's default unpack alignment of 4
+    const auto ROWBYTES = [format](const pixman_box32_t& r) { return ((r.x2 - r.x1) * format->bytesPerBlock + 3) & ~3; };
+
+    size_t     total = 0;
+    for (auto const& r : rects) {
+        total += (size_t)ROWBYTES(r) * (r.y2 - r.y1);
+    }
+
+    if (total < MIN_STAGED_BYTES || total > MAX_STAGED_BYTES)
+        return false;
+
+    const auto SLOT         = m_sUploadRing.next;
+    m_sUploadRing.next      = (m_sUploadRing.next + 1) % m_sUploadRing.ids.size();
+    auto&      id           = m_sUploadRing.ids[SLOT];
+    auto&      reservedSize = m_sUploadRing.sizes[SLOT];
+
+    if (!id)
+        glGenBuffers(1, &id);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
 
-    for (auto const& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: box.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_SCALECENTER: box.scaleFromCenter(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_TRANSLATE: box.translate(std::any_cast<Vector2D>(val)); break;
-                case RMOD_TYPE_ROTATE: box.rot += std::any_cast<float>(val); break;
-                case RMOD_TYPE_ROTATECENTER: {
-                    const auto   THETA = std::any_cast<float>(val);
-                    const double COS   = std::cos(THETA);
-                    const double SIN   = std::sin(THETA);
-                    box.rot += THETA;
-                    const auto OLDPOS = box.pos();
-                    box.x             = OLDPOS.x * COS - OLDPOS.y * SIN;
-                    box.y             = OLDPOS.y * COS + OLDPOS.x * SIN;
-                }
+    if (reservedSize < total) {
+        reservedSize = std::max(total, reservedSize * 2);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, reservedSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    // invalidating lets the driver hand out fresh storage instead of waiting for pending copies
+    auto dest = (uint8_t*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!dest) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    std::vector<size_t> offsets;
+    offsets.reserve(rects.size());
+
+    size_t offset = 0;
+    for (auto const& r : rects) {
+        const size_t ROW   = ROWBYTES(r);
+        const size_t WIDTH = (r.x2 - r.x1) * format->bytesPerBlock;
+
+        offsets.push_back(offset);
+        for (int y = r.y1; y < r.y2; ++y) {
+            memcpy(dest + offset, pixels + (size_t)y * stride + (size_t)r.x1 * format->bytesPerBlock, WIDTH);
+            offset += ROW;
+        }
+    }
+
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const auto& r = rects[i];
+        glTexSubImage2D(GL_TEXTURE_2D, 0, r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1, format->glFormat, format->glType, (const void*)offsets[i]);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    return true;
+#endif
+}
+
+void SRenderModifData::add(eRenderModifType type, float value) {
+    switch (type) {
+        case RMOD_TYPE_SCALE:
+            for (auto& v : posMatrix) {
+                v *= value;
+            }
+            for (auto& v : sizeMatrix) {
+                v *= value;
             }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::applyToBox!"); }
+            translate = translate * value;
+            sizeScale *= value;
+            regionScale *= value;
+            regionTranslate = regionTranslate * value;
+            scaleOnly *= value;
+            break;
+        case RMOD_TYPE_SCALECENTER:
+            // keeps the center: pos += size * (1 - scale) / 2, where size is the already transformed one
+            sizeMatrix[0] += sizeScale * (1.0 - value) / 2.0;
+            sizeMatrix[3] += sizeScale * (1.0 - value) / 2.0;
+            sizeScale *= value;
+            regionScale *= value;
+            regionTranslate = regionTranslate * value;
+            break;
+        case RMOD_TYPE_ROTATE:
+            rotation += value;
+            rotated = true;
+            break;
+        case RMOD_TYPE_ROTATECENTER: {
+            // rotates the position around the origin
+            const double COS = std::cos(value);
+            const double SIN = std::sin(value);
+
+            const auto   rotate = [COS, SIN](std::array<double, 4>& m) {
+                m = {COS * m[0] - SIN * m[2], COS * m[1] - SIN * m[3], SIN * m[0] + COS * m[2], SIN * m[1] + COS * m[3]};
+            };
+
+            rotate(posMatrix);
+            rotate(sizeMatrix);
+            translate = {translate.x * COS - translate.y * SIN, translate.y * COS + translate.x * SIN};
+            rotation += value;
+            rotated = true;
+            break;
+        }
+        default: Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: SRenderModifData::add with a float for modif type {}", (int)type); return;
     }
+
+    identity = false;
 }
 
-void SRenderModifData::applyToRegion(CRegion& rg) {
-    if (!enabled)
+void SRenderModifData::add(eRenderModifType type, const Vector2D& value) {
+    if (type != RMOD_TYPE_TRANSLATE) {
+        Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: SRenderModifData::add with a vector for modif type {}", (int)type);
         return;
+    }
 
-    for (auto const& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: rg.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_SCALECENTER: rg.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_TRANSLATE: rg.translate(std::any_cast<Vector2D>(val)); break;
-                case RMOD_TYPE_ROTATE: /* TODO */
-                case RMOD_TYPE_ROTATECENTER: break;
-            }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::applyToRegion!"); }
+    translate       = translate + value;
+    regionTranslate = regionTranslate + value;
+    identity        = false;
+}
+
+void SRenderModifData::applyToBox(CBox& box) const {
+    if (!enabled || identity)
+        return;
+
+    const Vector2D POS  = box.pos();
+    const Vector2D SIZE = box.size();
+
+    if (!rotated) {
+        box.x = posMatrix[0] * POS.x + sizeMatrix[0] * SIZE.x + translate.x;
+        box.y = posMatrix[3] * POS.y + sizeMatrix[3] * SIZE.y + translate.y;
+    } else {
+        box.x = posMatrix[0] * POS.x + posMatrix[1] * POS.y + sizeMatrix[0] * SIZE.x + sizeMatrix[1] * SIZE.y + translate.x;
+        box.y = posMatrix[2] * POS.x + posMatrix[3] * POS.y + sizeMatrix[2] * SIZE.x + sizeMatrix[3] * SIZE.y + translate.y;
+        box.rot += rotation;
     }
+
+    box.w = SIZE.x * sizeScale;
+    box.h = SIZE.y * sizeScale;
 }
 
-float SRenderModifData::combinedScale() {
+void SRenderModifData::applyToRegion(CRegion& rg) const {
+    if (!enabled || identity)
+        return;
+
+    if (regionScale != 1.0)
+        rg.scale(regionScale);
+    if (regionTranslate != Vector2D{})
+        rg.translate(regionTranslate);
+}
+
+float SRenderModifData::combinedScale() const {
     if (!enabled)
         return 1;
 
-    float scale = 1.f;
-    for (auto const& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: scale *= std::any_cast<float>(val); break;
-                case RMOD_TYPE_SCALECENTER:
-                case RMOD_TYPE_TRANSLATE:
-                case RMOD_TYPE_ROTATE:
-                case RMOD_TYPE_ROTATECENTER: break;
-            }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::combinedScale!"); }
-    }
-    return scale;
+    return scaleOnly;
+}
+
+bool SRenderModifData::empty() const {
+    return !enabled || identity;
 }
 
 CEGLSync::~CEGLSync() {
@@ -11,6 +11,7 @@
 #include <list>
 #include <unordered_map>
 #include <map>
+#include <array>
 
 #include <cairo/cairo.h>
 
@@ -52,13 +53,35 @@ struct SRenderModifData {
         RMOD_TYPE_ROTATECENTER, /* rotate by a float in rad from center */
     };
 
-    std::vector<std::pair<eRenderModifType, std::any>> modifs;
+    // modifiers are composed as they're added, applied in the order they were added
+    void  add(eRenderModifType type, float value);
+    void  add(eRenderModifType type, const Vector2D& value);
 
-    void                                               applyToBox(CBox& box);
-    void                                               applyToRegion(CRegion& rg);
-    float                                              combinedScale();
+    void  applyToBox(CBox& box) const;
+    void  applyToRegion(CRegion& rg) const;
+    float combinedScale() const;
+    bool  empty() const;
 
-    bool                                               enabled = true;
+    bool  enabled = true;
+
+  private:
+    // box: pos' = posMatrix * pos + sizeMatrix * size + translate, size' = size * sizeScale, rot' = rot + rotation
+    // matrices are row-major 2x2, they only have off-diagonal terms if rotated
+    std::array<double, 4> posMatrix  = {1, 0, 0, 1};
+    std::array<double, 4> sizeMatrix = {0, 0, 0, 0};
+    Vector2D              translate;
+    double                sizeScale = 1;
+    float                 rotation  = 0;
+    bool                  rotated   = false;
+
+    // regions ignore rotations, and scale from the origin even for RMOD_TYPE_SCALECENTER
+    double   regionScale = 1;
+    Vector2D regionTranslate;
+
+    // product of the RMOD_TYPE_SCALE modifiers only
+    float scaleOnly = 1;
+
+    bool  identity = true;
 };
 
 struct SMonitorRenderData {
@@ -74,15 +97,13 @@ struct SMonitorRenderData {
     CFramebuffer blurFB;
     bool         blurFBDirty        = true;
     bool         blurFBShouldRender = false;
+};
 
-    // Shaders
-    bool    m_bShadersInitialized = false;
+// programs live on the context, so they're shared by all monitors
+struct SPreparedShaders {
     CShader m_shQUAD;
-    CShader m_shRGBA;
     CShader m_shPASSTHRURGBA;
     CShader m_shMATTE;
-    CShader m_shRGBX;
-    CShader m_shEXT;
     CShader m_shBLUR1;
     CShader m_shBLUR2;
     CShader m_shBLURPREPARE;
@@ -90,7 +111,9 @@ struct SMonitorRenderData {
     CShader m_shSHADOW;
     CShader m_shBORDER1;
     CShader m_shGLITCH;
-    //
+
+    // texture shaders, compiled on first use. Indexed by texture type * (SH_FEAT_ALL + 1) + features
+    std::array<UP<CShader>, (TEXTURE_EXTERNAL + 1) * (SH_FEAT_ALL + 1)> m_vTextureShaders;
 };
 
 struct SCurrentRenderData {
@@ -123,6 +146,9 @@ struct SCurrentRenderData {
 
     uint32_t            discardMode    = DISCARD_OPAQUE;
     float               discardOpacity = 0.f;
+
+    // when set, textures get their rgb multiplied by this instead of the window dim. Reset by whoever sets it
+    std::optional<CHyprColor> textureTint;
 };
 
 class CEGLSync {
@@ -177,8 +203,10 @@ class CHyprOpenGLImpl {
     void     makeWindowSnapshot(PHLWINDOW);
     void     makeRawWindowSnapshot(PHLWINDOW, CFramebuffer*);
     void     makeLayerSnapshot(PHLLS);
+    void     makeWorkspaceSnapshot(PHLWORKSPACE);
     void     renderSnapshot(PHLWINDOW);
     void     renderSnapshot(PHLLS);
+    void     renderSnapshot(PHLWORKSPACE);
     bool     shouldUseNewBlurOptimizations(PHLLS pLayer, PHLWINDOW pWindow);
 
     void     clear(const CHyprColor&);
@@ -190,6 +218,7 @@ class CHyprOpenGLImpl {
     void     destroyMonitorResources(PHLMONITOR);
 
     void     markBlurDirtyForMonitor(PHLMONITOR);
+    double   getBlurRadius(); // how far blur samples around a pixel, in px
 
     void     preWindowPass();
     bool     preBlurQueued();
@@ -212,6 +241,10 @@ class CHyprOpenGLImpl {
     SP<CEGLSync>                                createEGLSync(int fenceFD);
     bool                                        waitForTimelinePoint(SP<CSyncTimeline> timeline, uint64_t point);
 
+    // packs the rects into a pixel unpack buffer and uploads them to the bound texture from there,
+    // so the copy to the GPU doesn't block. Returns false if staging isn't possible, upload directly then.
+    bool                                        uploadThroughStaging(const SPixelFormat* format, const uint8_t* pixels, uint32_t stride, const std::vector<pixman_box32_t>& rects);
+
     SCurrentRenderData                          m_RenderData;
 
     GLint                                       m_iCurrentOutputFb = 0;
@@ -233,6 +266,15 @@ class CHyprOpenGLImpl {
     std::map<PHLMONITORREF, SMonitorRenderData> m_mMonitorRenderResources;
     std::map<PHLMONITORREF, CFramebuffer>       m_mMonitorBGFBs;
 
+    SP<SPreparedShaders>                        m_shaders;
+
+    // windows of a sliding workspace, drawn without its render offset. Recaptured when dirty.
+    struct SWorkspaceSnapshot {
+        CFramebuffer fb;
+        bool         dirty = true;
+    };
+    std::map<PHLWORKSPACEREF, SWorkspaceSnapshot> m_mWorkspaceSnapshots;
+
     struct {
         PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC glEGLImageTargetRenderbufferStorageOES = nullptr;
         PFNGLEGLIMAGETARGETTEXTURE2DOESPROC           glEGLImageTargetTexture2DOES           = nullptr;
@@ -260,6 +302,15 @@ class CHyprOpenGLImpl {
         bool EXT_create_context_robustness      = false;
     } m_sExts;
 
+    // running totals, never reset. Consumers diff against their own snapshot.
+    struct SStats {
+        uint64_t drawCalls          = 0;
+        uint64_t textureUploads     = 0;
+        uint64_t uploadedBytes      = 0;
+        uint64_t framebufferAllocs  = 0;
+        uint64_t workspaceSnapshots = 0;
+    } m_sStats;
+
   private:
     std::list<GLuint>       m_lBuffers;
     std::list<GLuint>       m_lTextures;
@@ -279,6 +330,22 @@ class CHyprOpenGLImpl {
     CShader                 m_sFinalScreenShader;
     CTimer                  m_tGlobalTimer;
 
+    struct {
+        bool        enabled = false;
+        std::string path;
+    } m_sProgramCache;
+
+    // staging buffers for texture uploads, used round-robin so a buffer the GPU may still
+    // be copying from isn't mapped again right away
+    struct {
+        std::array<GLuint, 3> ids   = {};
+        std::array<size_t, 3> sizes = {};
+        size_t                next  = 0;
+    } m_sUploadRing;
+
+    // unit-quad vertices of the damage pieces drawn by drawQuadWithDamage, reused across draws
+    std::vector<float>      m_vDamageQuadVerts;
+
     SP<CTexture>            m_pMissingAssetTexture, m_pBackgroundTexture, m_pLockDeadTexture, m_pLockDead2Texture, m_pLockTtyTextTexture;
 
     void                    logShaderError(const GLuint&, bool program = false);
@@ -286,6 +353,10 @@ class CHyprOpenGLImpl {
     GLuint                  compileShader(const GLuint&, std::string, bool dynamic = false);
     void                    createBGTextureForMonitor(PHLMONITOR);
     void                    initShaders();
+    CShader*                getTextureShader(eTextureType type, uint8_t features);
+    void                    initProgramCache();
+    GLuint                  loadCachedProgram(uint64_t hash);
+    void                    storeCachedProgram(uint64_t hash, GLuint program);
     void                    initDRMFormats();
     void                    initEGL(bool gbm);
     EGLDeviceEXT            eglDeviceFromDRMFD(int drmFD);
@@ -293,6 +364,8 @@ class CHyprOpenGLImpl {
     SP<CTexture>            renderText(const std::string& text, CHyprColor col, int pt, bool italic = false);
     void                    initAssets();
     void                    initMissingAssetTexture();
+    void                    drawQuad();
+    void                    drawQuadWithDamage(const CBox& box, const CRegion& damage, GLint posAttrib, GLint texAttrib = -1);
 
     //
     std::optional<std::vector<uint64_t>> getModsForFormat(EGLint format);
@@ -19,6 +19,7 @@
 #include "../protocols/core/Compositor.hpp"
 #include "../protocols/DRMSyncobj.hpp"
 #include "../protocols/LinuxDMABUF.hpp"
+#include "../debug/RenderStats.hpp"
 #include "../helpers/sync/SyncTimeline.hpp"
 #include "debug/Log.hpp"
 
@@ -154,7 +155,7 @@ CHyprRenderer::~CHyprRenderer() {
         wl_event_source_remove(m_pCursorTicker);
 }
 
-static void renderSurface(SP<CWLSurfaceResource> surface, int x, int y, void* data) {
+static void renderSurface(const SP<CWLSurfaceResource>& surface, int x, int y, void* data) {
     if (!surface->current.texture)
         return;
 
@@ -485,8 +486,8 @@ void CHyprRenderer::renderWorkspaceWindows(PHLMONITOR pMonitor, PHLWORKSPACE pWo
 
     EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
 
-    std::vector<PHLWINDOWREF> windows;
-    windows.reserve(g_pCompositor->m_vWindows.size());
+    std::vector<PHLWINDOW> tiled, floating;
+    tiled.reserve(g_pCompositor->m_vWindows.size());
 
     for (auto const& w : g_pCompositor->m_vWindows) {
         if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
@@ -495,63 +496,86 @@ void CHyprRenderer::renderWorkspaceWindows(PHLMONITOR pMonitor, PHLWORKSPACE pWo
         if (!shouldRenderWindow(w, pMonitor))
             continue;
 
-        windows.push_back(w);
-    }
-
-    // Non-floating main
-    for (auto& w : windows) {
-        if (w->m_bIsFloating)
-            continue; // floating are in the second pass
-
         if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
             continue;
 
-        // render active window after all others of this pass
-        if (w == g_pCompositor->m_pLastWindow) {
-            lastWindow = w.lock();
+        if (isInWorkspaceSnapshot(w, pMonitor))
+            continue;
+
+        if (!w->m_bIsFloating) {
+            // render active window after all others of this pass
+            if (w == g_pCompositor->m_pLastWindow)
+                lastWindow = w;
+            else
+                tiled.push_back(w);
             continue;
         }
 
-        // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_MAIN);
+        if (w->m_bPinned)
+            continue;
+
+        if (pWorkspace->m_bIsSpecialWorkspace && w->m_pMonitor != pWorkspace->m_pMonitor)
+            continue; // special on another are rendered as a part of the base pass
+
+        floating.push_back(w);
     }
 
     if (lastWindow)
-        renderWindow(lastWindow, pMonitor, time, true, RENDER_PASS_MAIN);
+        tiled.push_back(lastWindow);
 
-    // Non-floating popup
-    for (auto& w : windows) {
-        if (!w)
-            continue;
+    // sliding workspaces with a snapshot are one texture each, below the live windows
+    if (!pWorkspace->m_bIsSpecialWorkspace) {
+        for (auto const& [ref, snapshot] : g_pHyprOpenGL->m_mWorkspaceSnapshots) {
+            const auto PWORKSPACE = ref.lock();
 
-        if (w->m_bIsFloating)
-            continue; // floating are in the second pass
+            if (PWORKSPACE && PWORKSPACE->m_pMonitor == pMonitor)
+                renderWorkspaceSnapshot(pMonitor, PWORKSPACE, time);
+        }
+    }
 
-        if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+    // walk front to back, so that every window only draws the damage not covered by something opaque drawn after it
+    const CRegion        BASEDAMAGE = g_pHyprOpenGL->m_RenderData.damage;
+    CRegion              occluded   = getOpaqueRegionAboveWindows(pMonitor);
+    std::vector<CRegion> tiledDamage(tiled.size()), floatingDamage(floating.size());
 
-        // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_POPUP);
-        w.reset();
+    for (size_t i = floating.size(); i-- > 0;) {
+        floatingDamage[i] = CRegion{BASEDAMAGE}.subtract(occluded);
+        occluded.add(getOpaqueRegionForWindow(floating[i], pMonitor));
     }
 
-    // floating on top
-    for (auto& w : windows) {
-        if (!w)
-            continue;
+    // popups of tiled windows go above all tiled windows
+    const CRegion POPUPDAMAGE = CRegion{BASEDAMAGE}.subtract(occluded);
 
-        if (!w->m_bIsFloating || w->m_bPinned)
-            continue;
+    for (size_t i = tiled.size(); i-- > 0;) {
+        tiledDamage[i] = CRegion{BASEDAMAGE}.subtract(occluded);
+        occluded.add(getOpaqueRegionForWindow(tiled[i], pMonitor));
+    }
 
-        if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+    // Non-floating main
+    for (size_t i = 0; i < tiled.size(); ++i) {
+        g_pHyprOpenGL->m_RenderData.damage = tiledDamage[i];
 
-        if (pWorkspace->m_bIsSpecialWorkspace && w->m_pMonitor != pWorkspace->m_pMonitor)
-            continue; // special on another are rendered as a part of the base pass
+        // render the bad boy
+        renderWindow(tiled[i], pMonitor, time, true, RENDER_PASS_MAIN);
+    }
+
+    // Non-floating popup
+    g_pHyprOpenGL->m_RenderData.damage = POPUPDAMAGE;
 
+    for (auto const& w : tiled) {
         // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_ALL);
+        renderWindow(w, pMonitor, time, true, RENDER_PASS_POPUP);
     }
+
+    // floating on top
+    for (size_t i = 0; i < floating.size(); ++i) {
+        g_pHyprOpenGL->m_RenderData.damage = floatingDamage[i];
+
+        // render the bad boy
+        renderWindow(floating[i], pMonitor, time, true, RENDER_PASS_ALL);
+    }
+
+    g_pHyprOpenGL->m_RenderData.damage = BASEDAMAGE;
 }
 
 void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, timespec* time, bool decorate, eRenderPassMode mode, bool ignorePosition, bool ignoreAllGeometry) {
@@ -615,6 +639,25 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, timespe
 
     g_pHyprOpenGL->m_pCurrentWindow = pWindow;
 
+    if (mode == RENDER_PASS_DECORATIONS_BELOW || mode == RENDER_PASS_DECORATIONS_ABOVE) {
+        const auto LAYERS = mode == RENDER_PASS_DECORATIONS_BELOW ? std::array{DECORATION_LAYER_BOTTOM, DECORATION_LAYER_UNDER} :
+                                                                    std::array{DECORATION_LAYER_OVER, DECORATION_LAYER_OVERLAY};
+
+        if (renderdata.decorate) {
+            for (const auto LAYER : LAYERS) {
+                for (auto const& wd : pWindow->m_dWindowDecorations) {
+                    if (wd->getDecorationLayer() != LAYER)
+                        continue;
+
+                    wd->draw(pMonitor, renderdata.alpha * renderdata.fadeAlpha);
+                }
+            }
+        }
+
+        g_pHyprOpenGL->m_pCurrentWindow.reset();
+        return;
+    }
+
     EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOW);
 
     if (*PDIMAROUND && pWindow->m_sWindowData.dimAround.valueOrDefault() && !m_bRenderingSnapshot && mode != RENDER_PASS_POPUP) {
@@ -626,7 +669,8 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, timespe
     renderdata.y += pWindow->m_vFloatingOffset.y;
 
     // if window is floating and we have a slide animation, clip it to its full bb
-    if (!ignorePosition && pWindow->m_bIsFloating && !pWindow->isFullscreen() && PWORKSPACE->m_vRenderOffset.isBeingAnimated() && !pWindow->m_bPinned) {
+    if (!ignorePosition && pWindow->m_bIsFloating && !pWindow->isFullscreen() && PWORKSPACE->m_vRenderOffset.isBeingAnimated() && !pWindow->m_bPinned &&
+        !m_bRenderingSnapshot) {
         CRegion rg =
             pWindow->getFullWindowBoundingBox().translate(-pMonitor->vecPosition + PWORKSPACE->m_vRenderOffset.value() + pWindow->m_vFloatingOffset).scale(pMonitor->scale);
         g_pHyprOpenGL->m_RenderData.clipBox = rg.getExtents();
@@ -674,8 +718,7 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, timespe
         }
 
         renderdata.surfaceCounter = 0;
-        pWindow->m_pWLSurface->resource()->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) { renderSurface(s, offset.x, offset.y, data); },
-                                                        &renderdata);
+        pWindow->m_pWLSurface->resource()->breadthfirst([&renderdata](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { renderSurface(s, offset.x, offset.y, &renderdata); });
 
         g_pHyprOpenGL->m_RenderData.useNearestNeighbor = false;
 
@@ -742,8 +785,7 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, timespe
                     rd->x += pos.x;
                     rd->y += pos.y;
 
-                    popup->m_pWLSurface->resource()->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) { renderSurface(s, offset.x, offset.y, data); },
-                                                                  data);
+                    popup->m_pWLSurface->resource()->breadthfirst([data](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { renderSurface(s, offset.x, offset.y, data); });
 
                     rd->x = oldPos.x;
                     rd->y = oldPos.y;
@@ -818,7 +860,7 @@ void CHyprRenderer::renderLayer(PHLLS pLayer, PHLMONITOR pMonitor, timespec* tim
     }
 
     if (!popups)
-        pLayer->surface->resource()->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) { renderSurface(s, offset.x, offset.y, data); }, &renderdata);
+        pLayer->surface->resource()->breadthfirst([&renderdata](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { renderSurface(s, offset.x, offset.y, &renderdata); });
 
     renderdata.squishOversized = false; // don't squish popups
     renderdata.dontRound       = true;
@@ -869,7 +911,7 @@ void CHyprRenderer::renderIMEPopup(CInputPopup* pPopup, PHLMONITOR pMonitor, tim
         g_pHyprOpenGL->m_RenderData.discardOpacity = *PBLURIGNOREA;
     }
 
-    SURF->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) { renderSurface(s, offset.x, offset.y, data); }, &renderdata);
+    SURF->breadthfirst([&renderdata](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { renderSurface(s, offset.x, offset.y, &renderdata); });
 
     g_pHyprOpenGL->m_RenderData.discardMode    = DM;
     g_pHyprOpenGL->m_RenderData.discardOpacity = DA;
@@ -884,7 +926,7 @@ void CHyprRenderer::renderSessionLockSurface(SSessionLockSurface* pSurface, PHLM
     renderdata.w        = pMonitor->vecSize.x;
     renderdata.h        = pMonitor->vecSize.y;
 
-    renderdata.surface->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) { renderSurface(s, offset.x, offset.y, data); }, &renderdata);
+    renderdata.surface->breadthfirst([&renderdata](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { renderSurface(s, offset.x, offset.y, &renderdata); });
 }
 
 void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* time, const Vector2D& translate, const float& scale) {
@@ -896,9 +938,9 @@ void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPA
 
     SRenderModifData RENDERMODIFDATA;
     if (translate != Vector2D{0, 0})
-        RENDERMODIFDATA.modifs.emplace_back(std::make_pair<>(SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, translate));
+        RENDERMODIFDATA.add(SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, translate);
     if (scale != 1.f)
-        RENDERMODIFDATA.modifs.emplace_back(std::make_pair<>(SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, scale));
+        RENDERMODIFDATA.add(SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, scale);
 
     if (!pMonitor)
         return;
@@ -1060,6 +1102,115 @@ void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPA
     g_pHyprOpenGL->m_RenderData.renderModif = {};
 }
 
+bool CHyprRenderer::shouldSnapshotWorkspace(PHLWORKSPACE pWorkspace) {
+    static auto PSNAPSHOTS = CConfigValue<Hyprlang::INT>("animations:workspace_snapshots");
+
+    // only plain slides, a fade changes the alpha the windows would be captured with
+    return *PSNAPSHOTS && pWorkspace && !pWorkspace->inert() && !pWorkspace->m_bIsSpecialWorkspace && !pWorkspace->m_bHasFullscreenWindow &&
+        pWorkspace->m_vRenderOffset.isBeingAnimated() && !pWorkspace->m_fAlpha.isBeingAnimated();
+}
+
+bool CHyprRenderer::isInWorkspaceSnapshot(PHLWINDOW pWindow, PHLMONITOR pMonitor) {
+    const auto PWORKSPACE = pWindow->m_pWorkspace;
+
+    if (!PWORKSPACE || !pWindow->m_bIsMapped || pWindow->m_bFadingOut || pWindow->isHidden() || pWindow->m_bPinned)
+        return false;
+
+    // on other monitors, the window is drawn live
+    if (pMonitor && PWORKSPACE->m_pMonitor != pMonitor)
+        return false;
+
+    return g_pHyprOpenGL->m_mWorkspaceSnapshots.contains(PWORKSPACE) && shouldSnapshotWorkspace(PWORKSPACE);
+}
+
+void CHyprRenderer::invalidateWorkspaceSnapshot(PHLWORKSPACE pWorkspace) {
+    for (auto& [ref, snapshot] : g_pHyprOpenGL->m_mWorkspaceSnapshots) {
+        if (!pWorkspace || ref.lock() == pWorkspace)
+            snapshot.dirty = true;
+    }
+}
+
+void CHyprRenderer::renderWorkspaceSnapshot(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* time) {
+    // same order as renderWorkspaceWindows, the focused tiled window last
+    std::vector<PHLWINDOW> windows;
+    PHLWINDOW              lastWindow;
+
+    for (const bool FLOATING : {false, true}) {
+        for (auto const& w : g_pCompositor->m_vWindows) {
+            if (w->m_pWorkspace != pWorkspace || w->m_bIsFloating != FLOATING || !isInWorkspaceSnapshot(w, pMonitor))
+                continue;
+
+            if (!FLOATING && w == g_pCompositor->m_pLastWindow)
+                lastWindow = w;
+            else
+                windows.push_back(w);
+        }
+
+        if (lastWindow) {
+            windows.push_back(lastWindow);
+            lastWindow.reset();
+        }
+    }
+
+    // decorations aren't in the snapshot, their colors and fades animate on every focus change.
+    // Drawing them all below and above it is fine since no windows overlap, see workspaceSnapshotKeepsStacking
+    for (auto const& w : windows) {
+        renderWindow(w, pMonitor, time, true, RENDER_PASS_DECORATIONS_BELOW);
+    }
+
+    g_pHyprOpenGL->renderSnapshot(pWorkspace);
+
+    for (auto const& w : windows) {
+        renderWindow(w, pMonitor, time, true, RENDER_PASS_DECORATIONS_ABOVE);
+    }
+}
+
+bool CHyprRenderer::workspaceSnapshotKeepsStacking(PHLWORKSPACE pWorkspace) {
+    // renderWorkspaceSnapshot draws all bottom decorations, then all windows, then all top decorations.
+    // That only matches the per-window order when no two windows (with decorations) overlap, and dim_around has nowhere to go.
+    std::vector<CBox> boxes;
+
+    for (auto const& w : g_pCompositor->m_vWindows) {
+        if (w->m_pWorkspace != pWorkspace || !w->m_bIsMapped || w->isHidden() || w->m_bPinned)
+            continue;
+
+        if (w->m_sWindowData.dimAround.valueOrDefault())
+            return false;
+
+        const auto BOX = w->getFullWindowBoundingBox();
+
+        if (std::ranges::any_of(boxes, [&BOX](const auto& other) { return !other.intersection(BOX).empty(); }))
+            return false;
+
+        boxes.push_back(BOX);
+    }
+
+    return true;
+}
+
+void CHyprRenderer::updateWorkspaceSnapshots(PHLMONITOR pMonitor) {
+    auto& snapshots = g_pHyprOpenGL->m_mWorkspaceSnapshots;
+
+    // drop the ones whose slide is over, or whose windows started overlapping
+    if (!snapshots.empty()) {
+        makeEGLCurrent();
+        std::erase_if(snapshots, [this](const auto& s) {
+            const auto PWORKSPACE = s.first.lock();
+            return !shouldSnapshotWorkspace(PWORKSPACE) || !workspaceSnapshotKeepsStacking(PWORKSPACE);
+        });
+    }
+
+    for (auto const& ws : g_pCompositor->m_vWorkspaces) {
+        if (ws->m_pMonitor != pMonitor || !shouldSnapshotWorkspace(ws) || !workspaceSnapshotKeepsStacking(ws))
+            continue;
+
+        const auto IT = snapshots.find(ws);
+
+        if (IT == snapshots.end() || IT->second.dirty)
+            g_pHyprOpenGL->makeWorkspaceSnapshot(ws);
+    }
+}
+
 void CHyprRenderer::renderLockscreen(PHLMONITOR pMonitor, timespec* now, const CBox& geometry) {
     TRACY_GPU_ZONE("RenderLockscreen");
 
@@ -1313,7 +1464,11 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
     pMonitor->tearingState.activelyTearing = shouldTear;
 
     if (*PDIRECTSCANOUT && !shouldTear) {
+        if (!pMonitor->solitaryClient.expired())
+            pMonitor->scanoutStats.candidateFrames++;
+
         if (pMonitor->attemptDirectScanout()) {
+            pMonitor->scanoutStats.scanoutFrames++;
             return;
         } else if (!pMonitor->lastScanout.expired()) {
             Debug::log(LOG, "Left a direct scanout.");
@@ -1348,6 +1503,8 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
     // we need to cleanup fading out when rendering the appropriate context
     g_pCompositor->cleanupFadingOut(pMonitor->ID);
 
+    updateWorkspaceSnapshots(pMonitor);
+
     // TODO: this is getting called with extents being 0,0,0,0 should it be?
     // potentially can save on resources.
 
@@ -1390,18 +1547,14 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
         // if we use blur we need to expand the damage for proper blurring
         // if framebuffer was not offloaded we're not doing introspection aka not blurring so this is redundant and dumb
         if (*PBLURENABLED == 1 && g_pHyprOpenGL->m_bOffloadedFramebuffer) {
-            // TODO: can this be optimized?
-            static auto PBLURSIZE   = CConfigValue<Hyprlang::INT>("decoration:blur:size");
-            static auto PBLURPASSES = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
-            const auto  BLURRADIUS =
-                *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES); // is this 2^pass? I don't know but it works... I think.
+            static auto PBLURRADIUS = CDerivedConfigValue<double>([] { return g_pHyprOpenGL->getBlurRadius(); });
 
             // now, prep the damage, get the extended damage region
-            damage.expand(BLURRADIUS); // expand for proper blurring
+            damage.expand(*PBLURRADIUS); // expand for proper blurring
 
             finalDamage = damage;
 
-            damage.expand(BLURRADIUS); // expand for proper blurring
+            damage.expand(*PBLURRADIUS); // expand for proper blurring
         } else
             finalDamage = damage;
     }
@@ -1512,6 +1665,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
 
     const float durationUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - renderStart).count() / 1000.f;
     g_pDebugOverlay->renderData(pMonitor, durationUs);
+    g_pRenderStats->onFrame(pMonitor, durationUs);
 
     if (*PDEBUGOVERLAY == 1) {
         if (pMonitor == g_pCompositor->m_vMonitors.front()) {
@@ -1606,7 +1760,7 @@ void CHyprRenderer::sendFrameEventsToWorkspace(PHLMONITOR pMonitor, PHLWORKSPACE
         if (!shouldRenderWindow(w, pMonitor))
             continue;
 
-        w->m_pWLSurface->resource()->breadthfirst([now](SP<CWLSurfaceResource> r, const Vector2D& offset, void* d) { r->frame(now); }, nullptr);
+        w->m_pWLSurface->resource()->breadthfirst([now](const SP<CWLSurfaceResource>& r, const Vector2D& offset) { r->frame(now); });
     }
 
     for (auto const& lsl : pMonitor->m_aLayerSurfaceLayers) {
@@ -1614,7 +1768,7 @@ void CHyprRenderer::sendFrameEventsToWorkspace(PHLMONITOR pMonitor, PHLWORKSPACE
             if (ls->fadingOut || !ls->surface->resource())
                 continue;
 
-            ls->surface->resource()->breadthfirst([now](SP<CWLSurfaceResource> r, const Vector2D& offset, void* d) { r->frame(now); }, nullptr);
+            ls->surface->resource()->breadthfirst([now](const SP<CWLSurfaceResource>& r, const Vector2D& offset) { r->frame(now); });
         }
     }
 }
@@ -1842,6 +1996,14 @@ void CHyprRenderer::damageSurface(SP<CWLSurfaceResource> pSurface, double x, dou
         return;
     }
 
+    // new contents make a snapshot showing them stale. Subsurfaces and popups don't know their window here, so those dirty all.
+    if (!g_pHyprOpenGL->m_mWorkspaceSnapshots.empty()) {
+        if (const auto PWINDOW = WLSURF->getWindow(); PWINDOW)
+            invalidateWorkspaceSnapshot(PWINDOW->m_pWorkspace);
+        else if (!WLSURF->getLayer())
+            invalidateWorkspaceSnapshot(nullptr);
+    }
+
     if (scale != 1.0)
         damageBox.scale(scale);
 
@@ -2033,6 +2195,9 @@ bool CHyprRenderer::applyMonitorRule(PHLMONITOR pMonitor, SMonitorRule* pMonitor
     pMonitor->drmFormat     = DRM_FORMAT_XRGB8888;
     pMonitor->output->state->resetExplicitFences();
 
+    // the output state changes under any rejected scanout buffers, give them another test
+    pMonitor->resetScanoutRejections();
+
     bool autoScale = false;
 
     if (RULE->scale > 0.1) {
@@ -2564,15 +2729,20 @@ void CHyprRenderer::setOccludedForMainWorkspace(CRegion& region, PHLWORKSPACE pW
     region.subtract(rg);
 }
 
+// how far blur samples around a window, anything opaque has to be shrunk by this to still occlude
+static double occlusionBlurRadius() {
+    static auto PBLUR       = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+    static auto PBLURRADIUS = CDerivedConfigValue<double>([] { return *PBLUR ? g_pHyprOpenGL->getBlurRadius() : 0.0; });
+
+    return *PBLURRADIUS;
+}
+
 void CHyprRenderer::setOccludedForBackLayers(CRegion& region, PHLWORKSPACE pWorkspace) {
-    CRegion     rg;
+    CRegion    rg;
 
-    const auto  PMONITOR = pWorkspace->m_pMonitor.lock();
+    const auto PMONITOR = pWorkspace->m_pMonitor.lock();
 
-    static auto PBLUR       = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
-    static auto PBLURSIZE   = CConfigValue<Hyprlang::INT>("decoration:blur:size");
-    static auto PBLURPASSES = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
-    const auto  BLURRADIUS  = *PBLUR ? (*PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES)) : 0;
+    const auto BLURRADIUS = occlusionBlurRadius();
 
     for (auto const& w : g_pCompositor->m_vWindows) {
         if (!w->m_bIsMapped || w->isHidden() || w->m_pWorkspace != pWorkspace)
@@ -2597,6 +2767,105 @@ void CHyprRenderer::setOccludedForBackLayers(CRegion& region, PHLWORKSPACE pWork
     region.subtract(rg);
 }
 
+CRegion CHyprRenderer::getOpaqueRegionForWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor) {
+    const auto PWORKSPACE = pWindow->m_pWorkspace;
+
+    if (!pWindow->m_bIsMapped || pWindow->m_bFadingOut || !PWORKSPACE || !pWindow->m_vTransformers.empty())
+        return {};
+
+    if (pWindow->m_iMonitorMovedFrom != -1 && !PWORKSPACE->isVisible())
+        return {}; // fading with m_fMovingToWorkspaceAlpha
+
+    // blurred surfaces below sample around their visible part, keep that margin drawn
+    const auto     BLURRADIUS = occlusionBlurRadius();
+
+    const auto     ROUNDING = pWindow->rounding() * pMonitor->scale;
+    const auto     OFFSET   = pWindow->m_vFloatingOffset + (pWindow->m_bPinned ? Vector2D{} : PWORKSPACE->m_vRenderOffset.value());
+    const Vector2D POS      = pWindow->m_vRealPosition.value() - pMonitor->vecPosition + OFFSET;
+    const Vector2D SIZE     = pWindow->m_vRealSize.value();
+
+    CBox           box = {POS.x + ROUNDING, POS.y + ROUNDING, SIZE.x - ROUNDING * 2, SIZE.y - ROUNDING * 2};
+
+    if (box.w <= 0 || box.h <= 0)
+        return {};
+
+    CRegion opaque;
+
+    if (pWindow->opaque())
+        opaque = box;
+    else {
+        // only parts of the window are opaque, which are trusted with blur off. Holes in them would need the same margin as the edges.
+        if (BLURRADIUS > 0 || pWindow->m_bIsX11 || !pWindow->m_pXDGSurface || !pWindow->m_pWLSurface->resource())
+            return {};
+
+        if (pWindow->m_fAlpha.value() != 1.f || pWindow->m_fActiveInactiveAlpha.value() != 1.f || (!pWindow->m_bPinned && PWORKSPACE->m_fAlpha.value() != 1.f))
+            return {};
+
+        if (pWindow->m_vRealSize.value().floor() != pWindow->m_vReportedSize || pWindow->m_pWLSurface->small())
+            return {};
+
+        opaque = pWindow->m_pWLSurface->resource()->current.opaque;
+        opaque.translate(POS - pWindow->m_pXDGSurface->current.geometry.pos()).intersect(box);
+    }
+
+    opaque.scale(pMonitor->scale);
+
+    if (BLURRADIUS > 0) {
+        CBox extents = opaque.getExtents();
+        opaque.intersect(extents.expand(-BLURRADIUS));
+    }
+
+    g_pHyprOpenGL->m_RenderData.renderModif.applyToRegion(opaque);
+
+    return opaque;
+}
+
+CRegion CHyprRenderer::getOpaqueRegionAboveWindows(PHLMONITOR pMonitor) {
+    CRegion rg;
+
+    // pinned windows
+    for (auto const& w : g_pCompositor->m_vWindows) {
+        if (w->isHidden() || !w->m_bPinned || !w->m_bIsFloating || !shouldRenderWindow(w, pMonitor))
+            continue;
+
+        rg.add(getOpaqueRegionForWindow(w, pMonitor));
+    }
+
+    const auto BLURRADIUS = occlusionBlurRadius();
+
+    for (auto const& layer : {ZWLR_LAYER_SHELL_V1_LAYER_TOP, ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY}) {
+        for (auto const& lsr : pMonitor->m_aLayerSurfaceLayers[layer]) {
+            const auto LS = lsr.lock();
+
+            if (!LS || !LS->mapped || LS->fadingOut || LS->alpha.value() < 1.f || !LS->surface->resource())
+                continue;
+
+            if (LS->realPosition.isBeingAnimated() || LS->realSize.isBeingAnimated())
+                continue;
+
+            CRegion opaque = LS->surface->resource()->current.opaque;
+            opaque.intersect(CBox{{}, LS->surface->resource()->current.size});
+
+            // the blur margin is only kept for a single opaque rect, see getOpaqueRegionForWindow
+            if (BLURRADIUS > 0 && opaque.getRects().size() != 1)
+                continue;
+
+            opaque.translate(LS->realPosition.value() - pMonitor->vecPosition).scale(pMonitor->scale);
+
+            if (BLURRADIUS > 0) {
+                CBox extents = opaque.getExtents();
+                opaque.intersect(extents.expand(-BLURRADIUS));
+            }
+
+            g_pHyprOpenGL->m_RenderData.renderModif.applyToRegion(opaque);
+
+            rg.add(opaque);
+        }
+    }
+
+    return rg;
+}
+
 bool CHyprRenderer::canSkipBackBufferClear(PHLMONITOR pMonitor) {
     for (auto const& ls : pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]) {
         if (!ls->layerSurface)
@@ -2681,6 +2950,38 @@ void CHyprRenderer::recheckSolitaryForMonitor(PHLMONITOR pMonitor) {
     pMonitor->solitaryClient = PCANDIDATE;
 }
 
+void CHyprRenderer::updateScanoutFeedback(PHLMONITOR pMonitor) {
+    static auto            PDIRECTSCANOUT = CConfigValue<Hyprlang::INT>("render:direct_scanout");
+
+    SP<CWLSurfaceResource> candidate;
+
+    // a solitary client whose buffers could go straight to the primary plane. Tell it what the plane takes, so its next allocation can.
+    if (*PDIRECTSCANOUT && !pMonitor->isMirror() && pMonitor->mirrors.empty()) {
+        const auto PWINDOW  = pMonitor->solitaryClient.lock();
+        const auto PSURFACE = PWINDOW ? g_pXWaylandManager->getWindowSurface(PWINDOW) : nullptr;
+
+        if (PSURFACE && PSURFACE->current.transform == pMonitor->transform)
+            candidate = PSURFACE;
+    }
+
+    const auto LAST = pMonitor->scanoutFeedbackSurface.lock();
+
+    if (candidate == LAST)
+        return;
+
+    // don't revert a surface that moved on to another monitor's tranche
+    const bool LASTELSEWHERE =
+        std::any_of(g_pCompositor->m_vMonitors.begin(), g_pCompositor->m_vMonitors.end(), [&](const auto& m) { return m != pMonitor && m->scanoutFeedbackSurface == LAST; });
+
+    if (LAST && !LASTELSEWHERE)
+        setSurfaceScanoutMode(LAST, nullptr);
+
+    if (candidate)
+        setSurfaceScanoutMode(candidate, pMonitor);
+
+    pMonitor->scanoutFeedbackSurface = candidate;
+}
+
 SP<CRenderbuffer> CHyprRenderer::getOrCreateRenderbuffer(SP<Aquamarine::IBuffer> buffer, uint32_t fmt) {
     auto it = std::find_if(m_vRenderbuffers.begin(), m_vRenderbuffers.end(), [&](const auto& other) { return other->m_pHLBuffer == buffer; });
 
@@ -25,7 +25,9 @@ enum eDamageTrackingModes : int8_t {
 enum eRenderPassMode : uint8_t {
     RENDER_PASS_ALL = 0,
     RENDER_PASS_MAIN,
-    RENDER_PASS_POPUP
+    RENDER_PASS_POPUP,
+    RENDER_PASS_DECORATIONS_BELOW, // only the bottom and under decoration layers, for windows drawn from a workspace snapshot
+    RENDER_PASS_DECORATIONS_ABOVE, // only the over and overlay decoration layers
 };
 
 enum eRenderMode : uint8_t {
@@ -69,8 +71,11 @@ class CHyprRenderer {
     void                            renderLockscreen(PHLMONITOR pMonitor, timespec* now, const CBox& geometry);
     void                            setOccludedForBackLayers(CRegion& region, PHLWORKSPACE pWorkspace);
     void                            setOccludedForMainWorkspace(CRegion& region, PHLWORKSPACE pWorkspace); // TODO: merge occlusion methods
+    CRegion                         getOpaqueRegionForWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor);      // in render coordinates
+    CRegion                         getOpaqueRegionAboveWindows(PHLMONITOR pMonitor);                      // pinned windows, top and overlay layers
     bool                            canSkipBackBufferClear(PHLMONITOR pMonitor);
     void                            recheckSolitaryForMonitor(PHLMONITOR pMonitor);
+    void                            updateScanoutFeedback(PHLMONITOR pMonitor);
     void                            setCursorSurface(SP<CWLSurface> surf, int hotspotX, int hotspotY, bool force = false);
     void                            setCursorFromName(const std::string& name, bool force = false);
     void                            onRenderbufferDestroy(CRenderbuffer* rb);
@@ -80,6 +85,8 @@ class CHyprRenderer {
     void                            unsetEGL();
     SExplicitSyncSettings           getExplicitSyncSettings();
     void                            addWindowToRenderUnfocused(PHLWINDOW window);
+    void                            invalidateWorkspaceSnapshot(PHLWORKSPACE pWorkspace); // nullptr for all
+    bool                            isInWorkspaceSnapshot(PHLWINDOW pWindow, PHLMONITOR pMonitor = nullptr);
 
     // if RENDER_MODE_NORMAL, provided damage will be written to.
     // otherwise, it will be the one used.
@@ -123,6 +130,10 @@ class CHyprRenderer {
     void              sendFrameEventsToWorkspace(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* now); // sends frame displayed events but doesn't actually render anything
     void              renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* now, const Vector2D& translate = {0, 0}, const float& scale = 1.f);
     void              renderSessionLockMissing(PHLMONITOR pMonitor);
+    bool              shouldSnapshotWorkspace(PHLWORKSPACE pWorkspace);
+    void              updateWorkspaceSnapshots(PHLMONITOR pMonitor);
+    bool              workspaceSnapshotKeepsStacking(PHLWORKSPACE pWorkspace);
+    void              renderWorkspaceSnapshot(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* time);
 
     bool              commitPendingAndDoExplicitSync(PHLMONITOR pMonitor);
 
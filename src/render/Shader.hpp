@@ -3,6 +3,16 @@
 #include "../defines.hpp"
 #include <unordered_map>
 
+// per-draw features of the texture shaders, each set is compiled into its own program
+enum eShaderFeatures : uint8_t {
+    SH_FEAT_DISCARD_OPAQUE = 1 << 0,
+    SH_FEAT_DISCARD_ALPHA  = 1 << 1,
+    SH_FEAT_TINT           = 1 << 2,
+    SH_FEAT_ROUNDING       = 1 << 3,
+
+    SH_FEAT_ALL = (1 << 4) - 1,
+};
+
 class CShader {
   public:
     ~CShader();
@@ -16,9 +26,7 @@ class CShader {
     GLint   posAttrib         = -1;
     GLint   texAttrib         = -1;
     GLint   matteTexAttrib    = -1;
-    GLint   discardOpaque     = -1;
-    GLint   discardAlpha      = -1;
-    GLfloat discardAlphaValue = -1;
+    GLint   discardAlphaValue = -1;
 
     GLint   topLeft               = -1;
     GLint   bottomRight           = -1;
@@ -35,8 +43,7 @@ class CShader {
     GLint   shadowPower   = -1;
     GLint   useAlphaMatte = -1; // always inverted
 
-    GLint   applyTint = -1;
-    GLint   tint      = -1;
+    GLint   tint = -1;
 
     GLint   gradient        = -1;
     GLint   gradientLength  = -1;
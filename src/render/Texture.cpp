@@ -5,6 +5,9 @@
 #include "../helpers/Format.hpp"
 #include <cstring>
 
+// beyond this many damage rects, the bounding box is uploaded instead
+constexpr size_t MAX_UPLOAD_RECTS = 16;
+
 CTexture::CTexture() = default;
 
 CTexture::~CTexture() {
@@ -82,7 +85,13 @@ void CTexture::createFromShm(uint32_t drmFormat, uint8_t* pixels, uint32_t strid
     GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0));
     GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
 
-    if (m_bKeepDataCopy) {
+    // null pixels only allocate the storage, the contents come with the first update
+    if (pixels) {
+        g_pHyprOpenGL->m_sStats.textureUploads++;
+        g_pHyprOpenGL->m_sStats.uploadedBytes += (uint64_t)stride * size_.y;
+    }
+
+    if (m_bKeepDataCopy && pixels) {
         m_vDataCopy.resize(stride * size_.y);
         memcpy(m_vDataCopy.data(), pixels, stride * size_.y);
     }
@@ -117,7 +126,21 @@ void CTexture::update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, cons
 
     glBindTexture(GL_TEXTURE_2D, m_iTexID);
 
-    auto rects = damage.copy().intersect(CBox{{}, m_vSize}).getRects();
+    auto region = damage.copy().intersect(CBox{{}, m_vSize});
+    auto rects  = region.getRects();
+
+    // fragmented damage costs more in per-call overhead than re-uploading the pixels in between
+    if (rects.size() > 1) {
+        const auto EXTENTS = region.getExtents();
+
+        size_t     damagedArea = 0;
+        for (auto const& r : rects) {
+            damagedArea += (size_t)(r.x2 - r.x1) * (r.y2 - r.y1);
+        }
+
+        if (rects.size() > MAX_UPLOAD_RECTS || damagedArea * 2 >= (size_t)(EXTENTS.width * EXTENTS.height))
+            rects = {pixman_box32_t{(int32_t)EXTENTS.x, (int32_t)EXTENTS.y, (int32_t)(EXTENTS.x + EXTENTS.width), (int32_t)(EXTENTS.y + EXTENTS.height)}};
+    }
 
 #ifndef GLES2
     if (format->flipRB) {
@@ -126,6 +149,14 @@ void CTexture::update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, cons
     }
 #endif
 
+    for (auto const& rect : rects) {
+        g_pHyprOpenGL->m_sStats.textureUploads++;
+        g_pHyprOpenGL->m_sStats.uploadedBytes += (uint64_t)(rect.x2 - rect.x1) * (rect.y2 - rect.y1) * format->bytesPerBlock;
+    }
+
+    if (g_pHyprOpenGL->uploadThroughStaging(format, pixels, stride, rects))
+        rects.clear();
+
     for (auto const& rect : rects) {
         GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / format->bytesPerBlock));
         GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, rect.x1));
@@ -2,6 +2,11 @@
 
 #include "../../Compositor.hpp"
 #include "../../config/ConfigValue.hpp"
+#include "../shaders/SharedValues.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
 
 CHyprDropShadowDecoration::CHyprDropShadowDecoration(PHLWINDOW pWindow) : IHyprWindowDecoration(pWindow), m_pWindow(pWindow) {
     ;
@@ -176,32 +181,36 @@ void CHyprDropShadowDecoration::draw(PHLMONITOR pMonitor, float const& a) {
         g_pHyprOpenGL->m_RenderData.damage.subtract(windowBox.copy().expand(-ROUNDING * pMonitor->scale)).intersect(saveDamage);
         g_pHyprOpenGL->m_RenderData.renderModif.applyToRegion(g_pHyprOpenGL->m_RenderData.damage);
 
-        alphaFB.bind();
+        // the atlas covers shadows whose window sits evenly inside them, e.g. not with an offset
+        if (!drawShadowSlices(fullBox, windowBox, ROUNDING * pMonitor->scale, *PSHADOWSIZE * pMonitor->scale, (ROUNDING + 1) * pMonitor->scale,
+                              PWINDOW->m_cRealShadowColor.value(), a)) {
+            alphaFB.bind();
 
-        // build the matte
-        // 10-bit formats have dogshit alpha channels, so we have to use the matte to its fullest.
-        // first, clear region of interest with black (fully transparent)
-        g_pHyprOpenGL->renderRect(&fullBox, CHyprColor(0, 0, 0, 1), 0);
+            // build the matte
+            // 10-bit formats have dogshit alpha channels, so we have to use the matte to its fullest.
+            // first, clear region of interest with black (fully transparent)
+            g_pHyprOpenGL->renderRect(&fullBox, CHyprColor(0, 0, 0, 1), 0);
 
-        // render white shadow with the alpha of the shadow color (otherwise we clear with alpha later and shit it to 2 bit)
-        drawShadowInternal(&fullBox, ROUNDING * pMonitor->scale, *PSHADOWSIZE * pMonitor->scale, CHyprColor(1, 1, 1, PWINDOW->m_cRealShadowColor.value().a), a);
+            // render white shadow with the alpha of the shadow color (otherwise we clear with alpha later and shit it to 2 bit)
+            drawShadowInternal(&fullBox, ROUNDING * pMonitor->scale, *PSHADOWSIZE * pMonitor->scale, CHyprColor(1, 1, 1, PWINDOW->m_cRealShadowColor.value().a), a);
 
-        // render black window box ("clip")
-        g_pHyprOpenGL->renderRect(&windowBox, CHyprColor(0, 0, 0, 1.0), (ROUNDING + 1 /* This fixes small pixel gaps. */) * pMonitor->scale);
+            // render black window box ("clip")
+            g_pHyprOpenGL->renderRect(&windowBox, CHyprColor(0, 0, 0, 1.0), (ROUNDING + 1 /* This fixes small pixel gaps. */) * pMonitor->scale);
 
-        alphaSwapFB.bind();
+            alphaSwapFB.bind();
 
-        // alpha swap just has the shadow color. It will be the "texture" to render.
-        g_pHyprOpenGL->renderRect(&fullBox, PWINDOW->m_cRealShadowColor.value().stripA(), 0);
+            // alpha swap just has the shadow color. It will be the "texture" to render.
+            g_pHyprOpenGL->renderRect(&fullBox, PWINDOW->m_cRealShadowColor.value().stripA(), 0);
 
-        LASTFB->bind();
+            LASTFB->bind();
 
-        CBox monbox = {0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y};
-        g_pHyprOpenGL->setMonitorTransformEnabled(true);
-        g_pHyprOpenGL->setRenderModifEnabled(false);
-        g_pHyprOpenGL->renderTextureMatte(alphaSwapFB.getTexture(), &monbox, alphaFB);
-        g_pHyprOpenGL->setRenderModifEnabled(true);
-        g_pHyprOpenGL->setMonitorTransformEnabled(false);
+            CBox monbox = {0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y};
+            g_pHyprOpenGL->setMonitorTransformEnabled(true);
+            g_pHyprOpenGL->setRenderModifEnabled(false);
+            g_pHyprOpenGL->renderTextureMatte(alphaSwapFB.getTexture(), &monbox, alphaFB);
+            g_pHyprOpenGL->setRenderModifEnabled(true);
+            g_pHyprOpenGL->setMonitorTransformEnabled(false);
+        }
 
         g_pHyprOpenGL->m_RenderData.damage = saveDamage;
     } else
@@ -227,3 +236,155 @@ void CHyprDropShadowDecoration::drawShadowInternal(CBox* box, int round, int ran
     else
         g_pHyprOpenGL->renderRoundedShadow(box, round, range, color, 1.F);
 }
+
+// what the rounded quad shader gives a pixel centered at p, see ROUNDED_SHADER_FUNC
+static double roundedRectCoverage(double px, double py, const CBox& box, double radius) {
+    if (px < box.x || py < box.y || px > box.x + box.w || py > box.y + box.h)
+        return 0.0;
+
+    if (radius <= 0)
+        return 1.0;
+
+    const double x = std::abs(px - (box.x + box.w / 2.0)) - (box.w / 2.0 - radius) + 1.0 / box.w;
+    const double y = std::abs(py - (box.y + box.h / 2.0)) - (box.h / 2.0 - radius) + 1.0 / box.h;
+
+    if (x + y <= radius)
+        return 1.0;
+
+    const double DIST = std::sqrt(x * x + y * y);
+
+    if (DIST > radius + SHADER_ROUNDED_SMOOTHING_FACTOR * 2.0)
+        return 0.0;
+
+    if (DIST > radius - SHADER_ROUNDED_SMOOTHING_FACTOR * 2.0) {
+        const double T = std::clamp((DIST - radius + SHADER_ROUNDED_SMOOTHING_FACTOR) / (SHADER_ROUNDED_SMOOTHING_FACTOR * 2.0), 0.0, 1.0);
+        return 1.0 - T * T * (3.0 - 2.0 * T);
+    }
+
+    return 1.0;
+}
+
+// what the shadow shader gives a pixel centered at p, for a size x size box
+static double roundedShadowAlpha(double px, double py, double size, double round, double range, double power) {
+    const double RADIUS = range + round;
+
+    const auto   alphaForDistance = [&](double distance) {
+        if (distance > RADIUS)
+            return 0.0;
+
+        if (distance > RADIUS - range)
+            return std::pow((range - (distance - RADIUS + range)) / range, power);
+
+        return 1.0;
+    };
+
+    const bool CORNERX = px < RADIUS || px > size - RADIUS;
+    const bool CORNERY = py < RADIUS || py > size - RADIUS;
+
+    if (CORNERX && CORNERY) {
+        const double CX = px < RADIUS ? RADIUS : size - RADIUS;
+        const double CY = py < RADIUS ? RADIUS : size - RADIUS;
+        return alphaForDistance(std::sqrt((px - CX) * (px - CX) + (py - CY) * (py - CY)));
+    }
+
+    const double SMALLEST = std::min({py, size - py, px, size - px});
+
+    if (SMALLEST < range)
+        return std::pow(SMALLEST / range, power);
+
+    return 1.0;
+}
+
+void CHyprDropShadowDecoration::rasterizeShadowAtlas() {
+    const auto&           ATLAS  = m_sShadowAtlas;
+    const int             SIZE   = ATLAS.corner * 2 + 1;
+    const CBox            CUTBOX = {ATLAS.inset, ATLAS.inset, SIZE - ATLAS.inset * 2, SIZE - ATLAS.inset * 2};
+
+    std::vector<uint32_t> pixels(SIZE * SIZE);
+
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            const double PX = x + 0.5, PY = y + 0.5;
+
+            const double SHADOW = ATLAS.sharp ? roundedRectCoverage(PX, PY, {0, 0, SIZE, SIZE}, ATLAS.round) :
+                                                roundedShadowAlpha(PX, PY, SIZE, ATLAS.round, ATLAS.range, ATLAS.power);
+            const double ALPHA  = std::clamp(SHADOW * (1.0 - roundedRectCoverage(PX, PY, CUTBOX, ATLAS.cutRound)), 0.0, 1.0);
+
+            // premultiplied white, the shadow color is applied when drawing
+            const uint32_t VALUE = std::round(ALPHA * 255.0);
+            pixels[y * SIZE + x] = (VALUE << 24) | (VALUE << 16) | (VALUE << 8) | VALUE;
+        }
+    }
+
+    m_sShadowAtlas.texture = makeShared<CTexture>(DRM_FORMAT_ARGB8888, (uint8_t*)pixels.data(), SIZE * 4, Vector2D{SIZE, SIZE});
+}
+
+bool CHyprDropShadowDecoration::drawShadowSlices(const CBox& fullBox, const CBox& windowBox, int round, int range, int cutRound, const CHyprColor& color, float a) {
+    static auto PSHADOWSHARP = CConfigValue<Hyprlang::INT>("decoration:shadow:sharp");
+    static auto PSHADOWPOWER = CConfigValue<Hyprlang::INT>("decoration:shadow:render_power");
+
+    const int   INSET = std::round(windowBox.x - fullBox.x);
+
+    if (INSET < 0 || INSET != std::round(windowBox.y - fullBox.y) || INSET != std::round(fullBox.x + fullBox.w - windowBox.x - windowBox.w) ||
+        INSET != std::round(fullBox.y + fullBox.h - windowBox.y - windowBox.h))
+        return false;
+
+    const int CORNER = std::max(range + round, INSET + cutRound) + 1;
+
+    if (fullBox.w < CORNER * 2 + 1 || fullBox.h < CORNER * 2 + 1)
+        return false;
+
+    const int POWER = std::clamp((int)*PSHADOWPOWER, 1, 4);
+
+    auto&     atlas = m_sShadowAtlas;
+
+    if (!atlas.texture || atlas.corner != CORNER || atlas.round != round || atlas.range != range || atlas.cutRound != cutRound || atlas.inset != INSET ||
+        atlas.power != POWER || atlas.sharp != !!*PSHADOWSHARP) {
+        atlas.corner   = CORNER;
+        atlas.round    = round;
+        atlas.range    = range;
+        atlas.cutRound = cutRound;
+        atlas.inset    = INSET;
+        atlas.power    = POWER;
+        atlas.sharp    = *PSHADOWSHARP;
+        rasterizeShadowAtlas();
+    }
+
+    // columns and rows: corner, stretched edge, corner. The edges sample the middle texel only.
+    const double                SIZE   = CORNER * 2 + 1;
+    const double                EDGEUV = (CORNER + 0.5) / SIZE;
+    const std::array<double, 3> POSX = {fullBox.x, fullBox.x + CORNER, fullBox.x + fullBox.w - CORNER};
+    const std::array<double, 3> POSY = {fullBox.y, fullBox.y + CORNER, fullBox.y + fullBox.h - CORNER};
+    const std::array<double, 3> LENX = {(double)CORNER, fullBox.w - CORNER * 2, (double)CORNER};
+    const std::array<double, 3> LENY = {(double)CORNER, fullBox.h - CORNER * 2, (double)CORNER};
+    const std::array<double, 3> UV0  = {0.0, EDGEUV, (CORNER + 1) / SIZE};
+    const std::array<double, 3> UV1  = {CORNER / SIZE, EDGEUV, 1.0};
+
+    // the shadow isn't dimmed or forced RGBX like the window
+    const auto SAVEDWINDOW = g_pHyprOpenGL->m_pCurrentWindow;
+    g_pHyprOpenGL->m_pCurrentWindow.reset();
+    g_pHyprOpenGL->m_RenderData.textureTint = color.stripA();
+
+    for (size_t x = 0; x < 3; ++x) {
+        for (size_t y = 0; y < 3; ++y) {
+            if (x == 1 && y == 1)
+                continue; // window
+
+            CBox slice = {POSX[x], POSY[y], LENX[x], LENY[y]};
+
+            if (slice.w <= 0 || slice.h <= 0)
+                continue;
+
+            g_pHyprOpenGL->m_RenderData.primarySurfaceUVTopLeft     = Vector2D{UV0[x], UV0[y]};
+            g_pHyprOpenGL->m_RenderData.primarySurfaceUVBottomRight = Vector2D{UV1[x], UV1[y]};
+            g_pHyprOpenGL->renderTexture(atlas.texture, &slice, color.a * a, 0, false, true);
+        }
+    }
+
+    g_pHyprOpenGL->m_RenderData.primarySurfaceUVTopLeft     = Vector2D(-1, -1);
+    g_pHyprOpenGL->m_RenderData.primarySurfaceUVBottomRight = Vector2D(-1, -1);
+    g_pHyprOpenGL->m_RenderData.textureTint                 = std::nullopt;
+    g_pHyprOpenGL->m_pCurrentWindow                         = SAVEDWINDOW;
+
+    return true;
+}
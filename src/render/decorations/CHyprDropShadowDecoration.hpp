@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IHyprWindowDecoration.hpp"
+#include "../Texture.hpp"
 
 class CHyprDropShadowDecoration : public IHyprWindowDecoration {
   public:
@@ -38,4 +39,16 @@ class CHyprDropShadowDecoration : public IHyprWindowDecoration {
 
     CBox         m_bLastWindowBox          = {0};
     CBox         m_bLastWindowBoxWithDecos = {0};
+
+    // ignore_window shadows are drawn as nine slices of this, with the window already cut out.
+    // The atlas is corner * 2 + 1 px wide, the middle row and column are the stretched edges.
+    // It's white, the shadow color is applied as a tint when drawing so color animations don't re-rasterize it.
+    struct {
+        SP<CTexture> texture;
+        int          corner = 0, round = 0, range = 0, cutRound = 0, inset = 0, power = 0;
+        bool         sharp = false;
+    } m_sShadowAtlas;
+
+    bool drawShadowSlices(const CBox& fullBox, const CBox& windowBox, int round, int range, int cutRound, const CHyprColor& color, float a);
+    void rasterizeShadowAtlas();
 };
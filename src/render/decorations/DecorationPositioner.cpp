@@ -64,6 +64,7 @@ void CDecorationPositioner::uncacheDecoration(IHyprWindowDecoration* deco) {
         return;
 
     WIT->second.needsRecalc = true;
+    WIT->second.generation++;
 }
 
 void CDecorationPositioner::repositionDeco(IHyprWindowDecoration* deco) {
@@ -81,21 +82,39 @@ CDecorationPositioner::SWindowPositioningData* CDecorationPositioner::getDataFor
 
     DATA->positioningInfo = pDecoration->getPositioningInfo();
 
+    invalidateWindow(pWindow);
+
     return DATA;
 }
 
 void CDecorationPositioner::sanitizeDatas() {
     std::erase_if(m_mWindowDatas, [](const auto& other) { return !valid(other.first); });
-    std::erase_if(m_vWindowPositioningDatas, [](const auto& other) {
+    std::erase_if(m_vWindowPositioningDatas, [this](const auto& other) {
         if (!validMapped(other->pWindow))
             return true;
         if (std::find_if(other->pWindow->m_dWindowDecorations.begin(), other->pWindow->m_dWindowDecorations.end(),
-                         [&](const auto& el) { return el.get() == other->pDecoration; }) == other->pWindow->m_dWindowDecorations.end())
+                         [&](const auto& el) { return el.get() == other->pDecoration; }) == other->pWindow->m_dWindowDecorations.end()) {
+            invalidateWindow(other->pWindow.lock());
             return true;
+        }
         return false;
     });
 }
 
+void CDecorationPositioner::invalidateWindow(PHLWINDOW pWindow) {
+    const auto WIT = m_mWindowDatas.find(pWindow);
+    if (WIT == m_mWindowDatas.end())
+        return;
+
+    WIT->second.generation++;
+}
+
+void CDecorationPositioner::invalidateAll() {
+    for (auto& [w, data] : m_mWindowDatas) {
+        data.generation++;
+    }
+}
+
 void CDecorationPositioner::forceRecalcFor(PHLWINDOW pWindow) {
     const auto WIT = std::find_if(m_mWindowDatas.begin(), m_mWindowDatas.end(), [&](const auto& other) { return other.first.lock() == pWindow; });
     if (WIT == m_mWindowDatas.end())
@@ -136,6 +155,8 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
     WINDOWDATA->needsRecalc    = false;
     const bool EPHEMERAL       = pWindow->m_vRealSize.isBeingAnimated();
 
+    WINDOWDATA->generation++;
+
     std::sort(datas.begin(), datas.end(), [](const auto& a, const auto& b) { return a->positioningInfo.priority > b->positioningInfo.priority; });
 
     CBox wb = pWindow->getWindowMainSurfaceBox();
@@ -289,11 +310,43 @@ SBoxExtents CDecorationPositioner::getWindowDecorationReserved(PHLWINDOW pWindow
 }
 
 SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOW pWindow, bool inputOnly) {
-    CBox const mainSurfaceBox = pWindow->getWindowMainSurfaceBox();
-    CBox       accum          = mainSurfaceBox;
+    return getCachedExtents(pWindow, inputOnly ? CACHED_EXTENTS_INPUT : CACHED_EXTENTS_FULL);
+}
+
+CBox CDecorationPositioner::getBoxWithIncludedDecos(PHLWINDOW pWindow) {
+    CBox box = pWindow->getWindowMainSurfaceBox();
+    box.addExtents(getCachedExtents(pWindow, CACHED_EXTENTS_MAIN));
+    return box;
+}
+
+SBoxExtents CDecorationPositioner::getCachedExtents(PHLWINDOW pWindow, eCachedExtents which) {
+    const auto MAINBOX = pWindow->getWindowMainSurfaceBox();
+    const auto WIT     = m_mWindowDatas.find(pWindow);
+
+    if (WIT == m_mWindowDatas.end())
+        return calculateExtents(pWindow, MAINBOX, which);
+
+    auto& cached = WIT->second.cachedExtents[which];
+
+    if (cached.generation != WIT->second.generation || cached.mainBox != MAINBOX)
+        cached = {WIT->second.generation, MAINBOX, calculateExtents(pWindow, MAINBOX, which)};
+
+    return cached.extents;
+}
+
+SBoxExtents CDecorationPositioner::calculateExtents(PHLWINDOW pWindow, const CBox& mainBox, eCachedExtents which) {
+    CBox accum = mainBox;
 
     for (auto const& data : m_vWindowPositioningDatas) {
-        if (!data->pDecoration || (inputOnly && !(data->pDecoration->getDecorationFlags() & DECORATION_ALLOWS_MOUSE_INPUT)))
+        if (!data->pDecoration)
+            continue;
+
+        const auto FLAGS = data->pDecoration->getDecorationFlags();
+
+        if (which == CACHED_EXTENTS_INPUT && !(FLAGS & DECORATION_ALLOWS_MOUSE_INPUT))
+            continue;
+
+        if (which == CACHED_EXTENTS_MAIN && !(FLAGS & DECORATION_PART_OF_MAIN_WINDOW))
             continue;
 
         auto const window = data->pWindow.lock();
@@ -302,7 +355,7 @@ SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOW pWindow,
 
         CBox decoBox;
         if (data->positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
-            decoBox = mainSurfaceBox;
+            decoBox = mainBox;
             decoBox.addExtents(data->positioningInfo.desiredExtents);
         } else {
             decoBox = data->lastReply.assignedGeometry;
@@ -334,45 +387,7 @@ SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOW pWindow,
             accum.addExtents(extentsToAdd);
     }
 
-    return accum.extentsFrom(mainSurfaceBox);
-}
-
-CBox CDecorationPositioner::getBoxWithIncludedDecos(PHLWINDOW pWindow) {
-    CBox accum = pWindow->getWindowMainSurfaceBox();
-
-    for (auto const& data : m_vWindowPositioningDatas) {
-        if (data->pWindow.lock() != pWindow)
-            continue;
-
-        if (!(data->pDecoration->getDecorationFlags() & DECORATION_PART_OF_MAIN_WINDOW))
-            continue;
-
-        CBox decoBox;
-
-        if (data->positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
-            decoBox = data->pWindow->getWindowMainSurfaceBox();
-            decoBox.addExtents(data->positioningInfo.desiredExtents);
-        } else {
-            decoBox              = data->lastReply.assignedGeometry;
-            const auto EDGEPOINT = getEdgeDefinedPoint(data->positioningInfo.edges, pWindow);
-            decoBox.translate(EDGEPOINT);
-        }
-
-        SBoxExtents extentsToAdd;
-
-        if (decoBox.x < accum.x)
-            extentsToAdd.topLeft.x = accum.x - decoBox.x;
-        if (decoBox.y < accum.y)
-            extentsToAdd.topLeft.y = accum.y - decoBox.y;
-        if (decoBox.x + decoBox.w > accum.x + accum.w)
-            extentsToAdd.bottomRight.x = (decoBox.x + decoBox.w) - (accum.x + accum.w);
-        if (decoBox.y + decoBox.h > accum.y + accum.h)
-            extentsToAdd.bottomRight.y = (decoBox.y + decoBox.h) - (accum.y + accum.h);
-
-        accum.addExtents(extentsToAdd);
-    }
-
-    return accum;
+    return accum.extentsFrom(mainBox);
 }
 
 CBox CDecorationPositioner::getWindowDecorationBox(IHyprWindowDecoration* deco) {
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 #include <map>
+#include <array>
 #include "../../helpers/math/Math.hpp"
 #include "../../desktop/DesktopTypes.hpp"
 
@@ -71,7 +72,24 @@ class CDecorationPositioner {
     CBox        getWindowDecorationBox(IHyprWindowDecoration* deco);
     void        forceRecalcFor(PHLWINDOW pWindow);
 
+    // drop cached extents, for changes that affect decoration flags (border_part_of_window, noborder, ...) without a resize
+    void invalidateWindow(PHLWINDOW pWindow);
+    void invalidateAll();
+
   private:
+    enum eCachedExtents : uint8_t {
+        CACHED_EXTENTS_FULL = 0,
+        CACHED_EXTENTS_INPUT,
+        CACHED_EXTENTS_MAIN, // only DECORATION_PART_OF_MAIN_WINDOW
+        CACHED_EXTENTS_COUNT,
+    };
+
+    struct SCachedExtents {
+        uint64_t    generation = 0;
+        CBox        mainBox;
+        SBoxExtents extents;
+    };
+
     struct SWindowPositioningData {
         PHLWINDOWREF                pWindow;
         IHyprWindowDecoration*      pDecoration = nullptr;
@@ -85,6 +103,10 @@ class CDecorationPositioner {
         SBoxExtents reserved       = {};
         SBoxExtents extents        = {};
         bool        needsRecalc    = false;
+
+        // bumped whenever the layout of the window's decorations changes, cached extents from older generations are stale
+        uint64_t                                         generation = 1;
+        std::array<SCachedExtents, CACHED_EXTENTS_COUNT> cachedExtents;
     };
 
     std::map<PHLWINDOWREF, SWindowData>                  m_mWindowDatas;
@@ -94,6 +116,8 @@ class CDecorationPositioner {
     void                                                 onWindowUnmap(PHLWINDOW pWindow);
     void                                                 onWindowMap(PHLWINDOW pWindow);
     void                                                 sanitizeDatas();
+    SBoxExtents                                          getCachedExtents(PHLWINDOW pWindow, eCachedExtents which);
+    SBoxExtents                                          calculateExtents(PHLWINDOW pWindow, const CBox& mainBox, eCachedExtents which);
 };
 
 inline std::unique_ptr<CDecorationPositioner> g_pDecorationPositioner;
\ No newline at end of file
@@ -98,6 +98,7 @@ void main() {
     v_texcoord = texcoord;
 })#";
 
+// texture shaders are specialized at compile time, see eShaderFeatures
 inline const std::string TEXFRAGSRCRGBA = R"#(
 precision highp float;
 varying vec2 v_texcoord; // is in 0-1
@@ -108,33 +109,34 @@ uniform vec2 topLeft;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-uniform int discardAlpha;
 uniform float discardAlphaValue;
 
-uniform int applyTint;
 uniform vec3 tint;
 
 void main() {
 
     vec4 pixColor = texture2D(tex, v_texcoord);
 
-    if (discardOpaque == 1 && pixColor[3] * alpha == 1.0)
+#ifdef DISCARD_OPAQUE
+    if (pixColor[3] * alpha == 1.0)
 	    discard;
+#endif
 
-    if (discardAlpha == 1 && pixColor[3] <= discardAlphaValue)
+#ifdef DISCARD_ALPHA
+    if (pixColor[3] <= discardAlphaValue)
         discard;
+#endif
 
-    if (applyTint == 1) {
-	    pixColor[0] = pixColor[0] * tint[0];
-	    pixColor[1] = pixColor[1] * tint[1];
-	    pixColor[2] = pixColor[2] * tint[2];
-    }
+#ifdef TINT
+    pixColor[0] = pixColor[0] * tint[0];
+    pixColor[1] = pixColor[1] * tint[1];
+    pixColor[2] = pixColor[2] * tint[2];
+#endif
 
-    if (radius > 0.0) {
+#ifdef ROUNDING
     )#" +
     ROUNDED_SHADER_FUNC("pixColor") + R"#(
-    }
+#endif
 
     gl_FragColor = pixColor * alpha;
 })#";
@@ -168,30 +170,27 @@ uniform vec2 topLeft;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-uniform int discardAlpha;
-uniform int discardAlphaValue;
-
-uniform int applyTint;
 uniform vec3 tint;
 
 void main() {
 
-    if (discardOpaque == 1 && alpha == 1.0)
+#ifdef DISCARD_OPAQUE
+    if (alpha == 1.0)
 	discard;
+#endif
 
     vec4 pixColor = vec4(texture2D(tex, v_texcoord).rgb, 1.0);
 
-    if (applyTint == 1) {
-	pixColor[0] = pixColor[0] * tint[0];
-	pixColor[1] = pixColor[1] * tint[1];
-	pixColor[2] = pixColor[2] * tint[2];
-    }
+#ifdef TINT
+    pixColor[0] = pixColor[0] * tint[0];
+    pixColor[1] = pixColor[1] * tint[1];
+    pixColor[2] = pixColor[2] * tint[2];
+#endif
 
-    if (radius > 0.0) {
+#ifdef ROUNDING
     )#" +
     ROUNDED_SHADER_FUNC("pixColor") + R"#(
-    }
+#endif
 
     gl_FragColor = pixColor * alpha;
 })#";
@@ -441,30 +440,27 @@ uniform vec2 topLeft;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-uniform int discardAlpha;
-uniform int discardAlphaValue;
-
-uniform int applyTint;
 uniform vec3 tint;
 
 void main() {
 
     vec4 pixColor = texture2D(texture0, v_texcoord);
 
-    if (discardOpaque == 1 && pixColor[3] * alpha == 1.0)
+#ifdef DISCARD_OPAQUE
+    if (pixColor[3] * alpha == 1.0)
 	discard;
+#endif
 
-    if (applyTint == 1) {
-	pixColor[0] = pixColor[0] * tint[0];
-	pixColor[1] = pixColor[1] * tint[1];
-	pixColor[2] = pixColor[2] * tint[2];
-    }
+#ifdef TINT
+    pixColor[0] = pixColor[0] * tint[0];
+    pixColor[1] = pixColor[1] * tint[1];
+    pixColor[2] = pixColor[2] * tint[2];
+#endif
 
-    if (radius > 0.0) {
+#ifdef ROUNDING
     )#" +
     ROUNDED_SHADER_FUNC("pixColor") + R"#(
-    }
+#endif
 
     gl_FragColor = pixColor * alpha;
 }